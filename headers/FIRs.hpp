@@ -1,6 +1,9 @@
 #pragma once
 
 #include "filter_type.hpp"
+#include "fir_design.hpp"
+#include "remez_design.hpp"
+#include "design_cache.hpp"
 
 namespace af{
 
@@ -15,6 +18,19 @@ namespace af{
             int m_order;
             double m_freq_cutoff;
 
+            /**
+             * @brief Helper returning coeffitients from Design_Cache, calculated by calc_coeff() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @return Returns shared coeffitients.
+             */
+            Shared_Coeff<T> cached_coeff(int order, double freq_cutoff){
+                Design_Key key{Design_Type::Lowpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, 0.0};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff(order, freq_cutoff)), {}};
+                }).coeff_b;
+            }
+
         public:
 
         /**
@@ -30,8 +46,20 @@ namespace af{
          * @param order Integer type order of filter.
          * @param freq_cutoff Double type cutoff frequency.
          */
-        Lowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff) :  FIR<T>(sampling_freq, filter_name, {0,1,0}), m_order(order), m_freq_cutoff(freq_cutoff) {
-            this->set_coeff(calc_coeff(order, freq_cutoff));
+        Lowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff) {
+            this->set_coeff(cached_coeff(order, freq_cutoff));
+        }
+
+        /**
+         * @brief Parametric construcotr of Lowpass filter object from already calculated coeffitients (used by lowpass_batch()).
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param coeff Vector of coeffitients calculated for given parameters, taken without copy.
+         */
+        Lowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, std::vector<T>&& coeff) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff) {
+            this->set_coeff(std::move(coeff));
         }
 
         /**
@@ -42,36 +70,7 @@ namespace af{
          * @return Returns vector of coeffitients in type of setting in object constructor.
          */
         std::vector<T> calc_coeff( int order, double freq_cutoff){    
-            std::vector<T> coeff(order + 1);
-
-            double fs = this->get_sampling_freq();
-            double omega = 2.0 * M_PI * (freq_cutoff/fs);
-            double M = order/2.0;
-
-            for(int i = 0; i <= order; i++){
-
-                double n = static_cast<double>(i) - M;
-
-                if(n==0){
-                    coeff[i] = static_cast<T>(omega/M_PI);
-                }
-
-                else {
-                    coeff[i] = static_cast<T>(std::sin(omega * n)/(M_PI * n));
-                }
-            }
-
-            double sum = 0;
-            for(T val : coeff) {
-                sum += static_cast<double>(val);
-            }
-            if(sum != 0){
-                for (T &val : coeff) {
-                    val /= static_cast<T>(sum);
-                }
-            }
-
-            return coeff;
+            return std::move(lowpass_coeff_batch<T>(this->get_sampling_freq(), order, {freq_cutoff})[0]);
         }
 
         /**
@@ -83,7 +82,21 @@ namespace af{
         void upadte_coeffs(int order, double freq_cutoff){
             m_order = order;
             m_freq_cutoff = freq_cutoff;
-            this->set_coeff(calc_coeff(order, freq_cutoff));
+            this->set_coeff(cached_coeff(order, freq_cutoff));
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see FIR::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param crossfade Number of samples for interpolation between old and new response.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, std::size_t crossfade = 0){
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            return this->request_coeff(cached_coeff(order, freq_cutoff), crossfade);
         }
 
         /**
@@ -123,6 +136,19 @@ namespace af{
             int m_order;
             double m_freq_cutoff;
 
+            /**
+             * @brief Helper returning coeffitients from Design_Cache, calculated by calc_coeff() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @return Returns shared coeffitients.
+             */
+            Shared_Coeff<T> cached_coeff(int order, double freq_cutoff){
+                Design_Key key{Design_Type::Highpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, 0.0};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff(order, freq_cutoff)), {}};
+                }).coeff_b;
+            }
+
         public:
 
         /**
@@ -138,8 +164,20 @@ namespace af{
          * @param order Integer type order of filter.
          * @param freq_cutoff Double type cutoff frequency.
          */
-        Highpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff) :  FIR<T>(sampling_freq, filter_name, {0,1,0}), m_order(order), m_freq_cutoff(freq_cutoff)  {
-            this->set_coeff(calc_coeff(order, freq_cutoff));
+        Highpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff)  {
+            this->set_coeff(cached_coeff(order, freq_cutoff));
+        }
+
+        /**
+         * @brief Parametric construcotr of Highpass filter object from already calculated coeffitients (used by highpass_batch()).
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param coeff Vector of coeffitients calculated for given parameters, taken without copy.
+         */
+        Highpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, std::vector<T>&& coeff) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff) {
+            this->set_coeff(std::move(coeff));
         }
         
         /**
@@ -150,26 +188,7 @@ namespace af{
          * @return Returns vector of coeffitients in type of setting in object constructor.
          */
         std::vector<T> calc_coeff( int order, double freq_cutoff){    
-            std::vector<T> coeff(order + 1);
-
-            double fs = this->get_sampling_freq();
-            double omega = 2.0 * M_PI * (freq_cutoff/fs);
-            double M = order/2.0;
-
-            for(int i = 0; i <= order; i++){
-
-                double n = static_cast<double>(i) - M;
-
-                if(n==0){
-                    coeff[i] = static_cast<T>((M_PI - omega)/M_PI);
-                }
-
-                else {
-                    coeff[i] = static_cast<T>(-1*std::sin(omega * n)/(M_PI * n));
-                }
-            }
-
-            return coeff;
+            return std::move(highpass_coeff_batch<T>(this->get_sampling_freq(), order, {freq_cutoff})[0]);
         }
 
         /**
@@ -181,7 +200,21 @@ namespace af{
         void upadte_coeffs(int order, double freq_cutoff){
             m_order = order;
             m_freq_cutoff = freq_cutoff;
-            this->set_coeff(calc_coeff(order, freq_cutoff));
+            this->set_coeff(cached_coeff(order, freq_cutoff));
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see FIR::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param crossfade Number of samples for interpolation between old and new response.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, std::size_t crossfade = 0){
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            return this->request_coeff(cached_coeff(order, freq_cutoff), crossfade);
         }
 
         /**
@@ -220,6 +253,20 @@ namespace af{
             double m_freq_cut_low;
             double m_freq_cut_high;
 
+            /**
+             * @brief Helper returning coeffitients from Design_Cache, calculated by calc_coeff() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cut_low Double type lower cutoff frequency.
+             * @param freq_cut_high Double type Higher cutoff frequency.
+             * @return Returns shared coeffitients.
+             */
+            Shared_Coeff<T> cached_coeff(int order, double freq_cut_low, double freq_cut_high){
+                Design_Key key{Design_Type::Bandpass, this->get_sampling_freq(), order, freq_cut_low, freq_cut_high, 0.0};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff(order, freq_cut_low, freq_cut_high)), {}};
+                }).coeff_b;
+            }
+
         public:
 
         /**
@@ -236,8 +283,21 @@ namespace af{
          * @param freq_cut_low Double type lower cutoff frequency.
          * @param freq_cut_high Double type Higher cutoff frequency. 
          */
-        Bandpass(double sampling_freq, std::string filter_name, int order, double freq_cut_low, double freq_cut_high) :  FIR<T>(sampling_freq, filter_name, {0,1,0}), m_order(order), m_freq_cut_low(freq_cut_low), m_freq_cut_high(freq_cut_high)  {
-            this->set_coeff(calc_coeff(order, freq_cut_low, freq_cut_high));
+        Bandpass(double sampling_freq, std::string filter_name, int order, double freq_cut_low, double freq_cut_high) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cut_low(freq_cut_low), m_freq_cut_high(freq_cut_high)  {
+            this->set_coeff(cached_coeff(order, freq_cut_low, freq_cut_high));
+        }
+
+        /**
+         * @brief Parametric construcotr of Bandpass filter object from already calculated coeffitients (used by bandpass_batch()).
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter.
+         * @param freq_cut_low Double type lower cutoff frequency.
+         * @param freq_cut_high Double type Higher cutoff frequency. 
+         * @param coeff Vector of coeffitients calculated for given parameters, taken without copy.
+         */
+        Bandpass(double sampling_freq, std::string filter_name, int order, double freq_cut_low, double freq_cut_high, std::vector<T>&& coeff) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cut_low(freq_cut_low), m_freq_cut_high(freq_cut_high) {
+            this->set_coeff(std::move(coeff));
         }
 
         /**
@@ -249,27 +309,7 @@ namespace af{
          * @return Returns vector of coeffitients in type of setting in object constructor.
          */
         std::vector<T> calc_coeff( int order, double freq_cut_low, double freq_cut_high){    
-            std::vector<T> coeff(order + 1);
-
-            double fs = this->get_sampling_freq();
-            double omega_1 = 2.0 * M_PI * (freq_cut_low/fs);
-            double omega_2 = 2.0 * M_PI * (freq_cut_high/fs);
-            double M = order/2.0;
-
-            for(int i = 0; i <= order; i++){
-
-                double n = static_cast<double>(i) - M;
-
-                if(n==0){
-                    coeff[i] = static_cast<T>((omega_2 - omega_1)/M_PI);
-                }
-
-                else {
-                    coeff[i] = static_cast<T>((std::sin(omega_2 * n) - std::sin(omega_1 * n))/(M_PI * n));
-                }
-            }
-
-            return coeff;
+            return std::move(bandpass_coeff_batch<T>(this->get_sampling_freq(), order, {freq_cut_low}, {freq_cut_high})[0]);
         }
 
         /**
@@ -282,7 +322,23 @@ namespace af{
             m_order = order;
             m_freq_cut_low = freq_cut_low;
             m_freq_cut_high = freq_cut_high;
-            this->set_coeff(calc_coeff(order, freq_cut_low, freq_cut_high));
+            this->set_coeff(cached_coeff(order, freq_cut_low, freq_cut_high));
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see FIR::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cut_low Double type lower cutoff frequency.
+         * @param freq_cut_high Double type Higher cutoff frequency.
+         * @param crossfade Number of samples for interpolation between old and new response.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cut_low, double freq_cut_high, std::size_t crossfade = 0){
+            m_order = order;
+            m_freq_cut_low = freq_cut_low;
+            m_freq_cut_high = freq_cut_high;
+            return this->request_coeff(cached_coeff(order, freq_cut_low, freq_cut_high), crossfade);
         }
 
         /**
@@ -329,6 +385,20 @@ namespace af{
         double m_freq_cut_low;
         double m_freq_cut_high;
 
+        /**
+         * @brief Helper returning coeffitients from Design_Cache, calculated by calc_coeff() on miss.
+         * @param order Integer type order of filter.
+         * @param freq_cut_low Double type lower cutoff frequency.
+         * @param freq_cut_high Double type Higher cutoff frequency.
+         * @return Returns shared coeffitients.
+         */
+        Shared_Coeff<T> cached_coeff(int order, double freq_cut_low, double freq_cut_high){
+            Design_Key key{Design_Type::Bandstop, this->get_sampling_freq(), order, freq_cut_low, freq_cut_high, 0.0};
+            return Design_Cache<T>::instance().get(key, [&] {
+                return Design_Entry<T>{Shared_Coeff<T>(calc_coeff(order, freq_cut_low, freq_cut_high)), {}};
+            }).coeff_b;
+        }
+
     public:
 
         /**
@@ -346,9 +416,22 @@ namespace af{
          * @param freq_cut_high Double type Higher cutoff frequency. 
          */
         Bandstop(double sampling_freq, std::string filter_name, int order, double freq_cut_low, double freq_cut_high) 
-            : FIR<T>(sampling_freq, filter_name, {0,1,0}), m_order(order), m_freq_cut_low(freq_cut_low), m_freq_cut_high(freq_cut_high)  
+            : FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cut_low(freq_cut_low), m_freq_cut_high(freq_cut_high)  
         {
-            this->set_coeff(calc_coeff(order, freq_cut_low, freq_cut_high));
+            this->set_coeff(cached_coeff(order, freq_cut_low, freq_cut_high));
+        }
+
+        /**
+         * @brief Parametric construcotr of Bandstop filter object from already calculated coeffitients (used by bandstop_batch()).
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter.
+         * @param freq_cut_low Double type lower cutoff frequency.
+         * @param freq_cut_high Double type Higher cutoff frequency. 
+         * @param coeff Vector of coeffitients calculated for given parameters, taken without copy.
+         */
+        Bandstop(double sampling_freq, std::string filter_name, int order, double freq_cut_low, double freq_cut_high, std::vector<T>&& coeff) :  FIR<T>(sampling_freq, filter_name), m_order(order), m_freq_cut_low(freq_cut_low), m_freq_cut_high(freq_cut_high) {
+            this->set_coeff(std::move(coeff));
         }
 
         /**
@@ -360,32 +443,30 @@ namespace af{
          * @return Returns vector of coeffitients in type of setting in object constructor.
          */
         std::vector<T> calc_coeff(int order, double freq_cut_low, double freq_cut_high) {    
-            std::vector<T> coeff(order + 1);
-
-            double fs = this->get_sampling_freq();
-            double omega_1 = 2.0 * M_PI * (freq_cut_low / fs);
-            double omega_2 = 2.0 * M_PI * (freq_cut_high / fs);
-            double M = order / 2.0;
-
-            for (int i = 0; i <= order; i++) {
-                double n = static_cast<double>(i) - M;
-
-                if (n == 0) {
-                    coeff[i] = static_cast<T>((M_PI - omega_2 + omega_1) / M_PI);
-                }
-                else {
-                    coeff[i] = static_cast<T>((std::sin(omega_1 * n) - std::sin(omega_2 * n)) / (M_PI * n));
-                }
-            }
-
-            return coeff;
+            return std::move(bandstop_coeff_batch<T>(this->get_sampling_freq(), order, {freq_cut_low}, {freq_cut_high})[0]);
         }
 
        void upadte_coeffs(int order, double freq_cut_low, double freq_cut_high){
             m_order = order;
             m_freq_cut_low = freq_cut_low;
             m_freq_cut_high = freq_cut_high;
-            this->set_coeff(calc_coeff(order, freq_cut_low, freq_cut_high));
+            this->set_coeff(cached_coeff(order, freq_cut_low, freq_cut_high));
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see FIR::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cut_low Double type lower cutoff frequency.
+         * @param freq_cut_high Double type Higher cutoff frequency.
+         * @param crossfade Number of samples for interpolation between old and new response.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cut_low, double freq_cut_high, std::size_t crossfade = 0){
+            m_order = order;
+            m_freq_cut_low = freq_cut_low;
+            m_freq_cut_high = freq_cut_high;
+            return this->request_coeff(cached_coeff(order, freq_cut_low, freq_cut_high), crossfade);
         }
 
         /**
@@ -419,4 +500,248 @@ namespace af{
             return m_freq_cut_high;
         }
     };
+
+    /**
+     * @brief Builds many Lowpass filters of the same order in one call (see lowpass_coeff_batch()).
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of every filter.
+     * @param order Integer type order of filters.
+     * @param freq_cutoff Vector of cutoff frequencies, one filter is made for each.
+     * @return Returns vector of Lowpass filters.
+     */
+    template <typename T>
+    std::vector<Lowpass<T>> lowpass_batch(double sampling_freq, std::string filter_name, int order, const std::vector<double>& freq_cutoff){
+        std::vector<std::vector<T>> coeffs = lowpass_coeff_batch<T>(sampling_freq, order, freq_cutoff);
+        std::vector<Lowpass<T>> filters;
+        filters.reserve(coeffs.size());
+
+        for (std::size_t d = 0; d < coeffs.size(); d++) {
+            filters.emplace_back(sampling_freq, filter_name, order, freq_cutoff[d], std::move(coeffs[d]));
+        }
+
+        return filters;
+    }
+
+    /**
+     * @brief Builds many Highpass filters of the same order in one call (see highpass_coeff_batch()).
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of every filter.
+     * @param order Integer type order of filters.
+     * @param freq_cutoff Vector of cutoff frequencies, one filter is made for each.
+     * @return Returns vector of Highpass filters.
+     */
+    template <typename T>
+    std::vector<Highpass<T>> highpass_batch(double sampling_freq, std::string filter_name, int order, const std::vector<double>& freq_cutoff){
+        std::vector<std::vector<T>> coeffs = highpass_coeff_batch<T>(sampling_freq, order, freq_cutoff);
+        std::vector<Highpass<T>> filters;
+        filters.reserve(coeffs.size());
+
+        for (std::size_t d = 0; d < coeffs.size(); d++) {
+            filters.emplace_back(sampling_freq, filter_name, order, freq_cutoff[d], std::move(coeffs[d]));
+        }
+
+        return filters;
+    }
+
+    /**
+     * @brief Builds many Bandpass filters of the same order in one call (see bandpass_coeff_batch()).
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of every filter.
+     * @param order Integer type order of filters.
+     * @param freq_cut_low Vector of lower cutoff frequencies.
+     * @param freq_cut_high Vector of higher cutoff frequencies (same size as lower).
+     * @return Returns vector of Bandpass filters. Empty if sizes of vectors differ.
+     */
+    template <typename T>
+    std::vector<Bandpass<T>> bandpass_batch(double sampling_freq, std::string filter_name, int order, const std::vector<double>& freq_cut_low, const std::vector<double>& freq_cut_high){
+        std::vector<std::vector<T>> coeffs = bandpass_coeff_batch<T>(sampling_freq, order, freq_cut_low, freq_cut_high);
+        std::vector<Bandpass<T>> filters;
+        filters.reserve(coeffs.size());
+
+        for (std::size_t d = 0; d < coeffs.size(); d++) {
+            filters.emplace_back(sampling_freq, filter_name, order, freq_cut_low[d], freq_cut_high[d], std::move(coeffs[d]));
+        }
+
+        return filters;
+    }
+
+    /**
+     * @brief Builds many Bandstop filters of the same order in one call (see bandstop_coeff_batch()).
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of every filter.
+     * @param order Integer type order of filters.
+     * @param freq_cut_low Vector of lower cutoff frequencies.
+     * @param freq_cut_high Vector of higher cutoff frequencies (same size as lower).
+     * @return Returns vector of Bandstop filters. Empty if sizes of vectors differ.
+     */
+    template <typename T>
+    std::vector<Bandstop<T>> bandstop_batch(double sampling_freq, std::string filter_name, int order, const std::vector<double>& freq_cut_low, const std::vector<double>& freq_cut_high){
+        std::vector<std::vector<T>> coeffs = bandstop_coeff_batch<T>(sampling_freq, order, freq_cut_low, freq_cut_high);
+        std::vector<Bandstop<T>> filters;
+        filters.reserve(coeffs.size());
+
+        for (std::size_t d = 0; d < coeffs.size(); d++) {
+            filters.emplace_back(sampling_freq, filter_name, order, freq_cut_low[d], freq_cut_high[d], std::move(coeffs[d]));
+        }
+
+        return filters;
+    }
+
+    /**
+     * @brief Builds Lowpass filter of minimal order meeting the specification (see kaiser_lowpass_coeff()).
+     * * Cutoff frequency of filter is the middle of transition band.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Lowpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Lowpass<T> kaiser_lowpass(double sampling_freq, std::string filter_name, const FIR_Spec& spec){
+        std::vector<T> coeff = kaiser_lowpass_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Lowpass<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_pass + spec.freq_stop), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds Highpass filter of minimal (even) order meeting the specification (see kaiser_highpass_coeff()).
+     * * Cutoff frequency of filter is the middle of transition band.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Highpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Highpass<T> kaiser_highpass(double sampling_freq, std::string filter_name, const FIR_Spec& spec){
+        std::vector<T> coeff = kaiser_highpass_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Highpass<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_pass + spec.freq_stop), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds Bandpass filter of minimal order meeting the specification (see kaiser_bandpass_coeff()).
+     * * Cutoff frequencies of filter are the middles of transition bands.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Bandpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Bandpass<T> kaiser_bandpass(double sampling_freq, std::string filter_name, const FIR_Band_Spec& spec){
+        std::vector<T> coeff = kaiser_bandpass_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Bandpass<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_stop_low + spec.freq_pass_low),
+                           0.5 * (spec.freq_pass_high + spec.freq_stop_high), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds Bandstop filter of minimal (even) order meeting the specification (see kaiser_bandstop_coeff()).
+     * * Cutoff frequencies of filter are the middles of transition bands.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Bandstop filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Bandstop<T> kaiser_bandstop(double sampling_freq, std::string filter_name, const FIR_Band_Spec& spec){
+        std::vector<T> coeff = kaiser_bandstop_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Bandstop<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_pass_low + spec.freq_stop_low),
+                           0.5 * (spec.freq_stop_high + spec.freq_pass_high), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds equiripple Lowpass filter of minimal order meeting the specification (see remez_lowpass_coeff()).
+     * * Cutoff frequency of filter is the middle of transition band.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Lowpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Lowpass<T> remez_lowpass(double sampling_freq, std::string filter_name, const FIR_Spec& spec){
+        std::vector<T> coeff = remez_lowpass_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Lowpass<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_pass + spec.freq_stop), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds equiripple Highpass filter of minimal (even) order meeting the specification (see remez_highpass_coeff()).
+     * * Cutoff frequency of filter is the middle of transition band.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Highpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Highpass<T> remez_highpass(double sampling_freq, std::string filter_name, const FIR_Spec& spec){
+        std::vector<T> coeff = remez_highpass_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Highpass<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_pass + spec.freq_stop), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds equiripple Bandpass filter of minimal order meeting the specification (see remez_bandpass_coeff()).
+     * * Cutoff frequencies of filter are the middles of transition bands.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Bandpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Bandpass<T> remez_bandpass(double sampling_freq, std::string filter_name, const FIR_Band_Spec& spec){
+        std::vector<T> coeff = remez_bandpass_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Bandpass<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_stop_low + spec.freq_pass_low),
+                           0.5 * (spec.freq_pass_high + spec.freq_stop_high), std::move(coeff));
+    }
+
+    /**
+     * @brief Builds equiripple Bandstop filter of minimal (even) order meeting the specification (see remez_bandstop_coeff()).
+     * * Cutoff frequencies of filter are the middles of transition bands.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @return Returns Bandstop filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Bandstop<T> remez_bandstop(double sampling_freq, std::string filter_name, const FIR_Band_Spec& spec){
+        std::vector<T> coeff = remez_bandstop_coeff<T>(sampling_freq, spec);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Bandstop<T>(sampling_freq, filter_name, order, 0.5 * (spec.freq_pass_low + spec.freq_stop_low),
+                           0.5 * (spec.freq_stop_high + spec.freq_pass_high), std::move(coeff));
+    }
+
+
+    /**
+     * @brief Builds halfband Lowpass filter (cutoff sampling_freq / 4) of minimal order (see halfband_coeff()).
+     * * Every other tap is exactly zero, so FIR runs zero skipping kernel (Tap_Layout::Halfband). Used for 2:1 decimation.
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param transition Width of transition band centered at sampling_freq / 4 in Hz.
+     * @param stop_atten Minimal stopband attenuation in dB (passband deviation is the same).
+     * @return Returns Lowpass filter, get_order() is -1 and filter passes samples unchanged if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    Lowpass<T> halfband_lowpass(double sampling_freq, std::string filter_name, double transition, double stop_atten){
+        std::vector<T> coeff = halfband_coeff<T>(sampling_freq, transition, stop_atten);
+        int order = static_cast<int>(coeff.size()) - 1;
+        return Lowpass<T>(sampling_freq, filter_name, order, 0.25 * sampling_freq, std::move(coeff));
+    }
+
+    /**
+     * @brief Builds Hilbert transformer FIR of minimal order (see hilbert_coeff()).
+     * * Every other tap is exactly zero, so FIR runs zero skipping kernel (Tap_Layout::Alternating).
+     * @param sampling_freq Double type Sampling frequency if signal input.
+     * @param filter_name String type Name of filter.
+     * @param transition Width of transition bands at 0 Hz and at sampling_freq / 2 in Hz.
+     * @param atten Maximal deviation of magnitude from 1 in dB below 1.
+     * @return Returns FIR filter, without coeffitients (passes samples unchanged) if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    FIR<T> hilbert(double sampling_freq, std::string filter_name, double transition, double atten){
+        FIR<T> filter(sampling_freq, filter_name);
+        filter.set_coeff(hilbert_coeff<T>(sampling_freq, transition, atten));
+        return filter;
+    }
+
 }
@@ -1,92 +1,237 @@
 #pragma once
 
 #include "filter_type.hpp"
+#include "design_cache.hpp"
+#include "iir_design.hpp"
 
 namespace af{  
 
     /**
-     * @brief ChebyshevLowpass filter class is used to calculate chebyschev 1 type Lowpass coeffitiens for biquad filter and set them. 
-     * * Class hold order(not used) of the filter, cutoff frequencies, passband ripple and methods for calucating coeffitients and updateing filter runing.
+     * @brief ChebyshevLowpass filter class is used to calculate chebyschev 1 type lowpass coeffitients of given order and set them as second order sections.
+     * * Class hold order of the filter, cutoff frequency, ripple and methods for calucating coeffitients and updateing filter runing.
      * @tparam T is sample input type numeric data.
      */
     template <typename T>
-    class ChebyshevLowpass : public IIR<T> {
+    class ChebyshevLowpass : public SOS<T> {
         private:
             int m_order;
             double m_freq_cutoff;
             double m_pass_ripple;
 
+            /**
+             * @brief Helper returning sections from Design_Cache, calculated by calc_coeff_sos() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @param ripple Double type passband ripple of filter in dB.
+             * @return Returns shared sections in coeffitients b.
+             */
+            Design_Entry<T> cached_coeff(int order, double freq_cutoff, double ripple){
+                Design_Key key{Design_Type::ChebyshevLowpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, ripple};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff_sos(order, freq_cutoff, ripple)), Shared_Coeff<T>()};
+                });
+            }
+
         public:
 
         /**
-        * @brief Deafault constructor of ChebyshevLowpass object. 
-        * * Sets basic values for allpass filter.
+        * @brief Deafault constructor of ChebyshevLowpass object.
+        * * Designs filter of order 2, cutoff 2250 Hz, ripple 1 dB at sampling frequency 44100 Hz.
         */
-        ChebyshevLowpass() : IIR<T>(44100.0, "Chebychev Lowpass", {0,1,0}, {0,0}), m_order(2), m_freq_cutoff(2250.0) {}
-        
+        ChebyshevLowpass() : ChebyshevLowpass(44100.0, "ChebyshevLowpass", 2, 2250.0, 1.0) {}
+
         /**
          * @brief Parametric construcotr of ChebyshevLowpass filter object.
+         * * Filter without valid design (order below 1, cutoff outside 0 - sampling_freq / 2) has no sections and passes samples unchanged.
          * @param sampling_freq Double type Sampling frequency if signal input.
          * @param filter_name String type Name of filter.
-         * @param order Integer type order of filter.
-         * @param freq_cutoff Double type lower cutoff frequency.
-         * @param ripple Double type passband ripple of filter. 
+         * @param order Integer type order of filter (odd order adds first order section).
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
          */
-        ChebyshevLowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, double ripple) :  IIR<T>(sampling_freq, filter_name, {0,1,0}, {0,0}), m_order(order), m_freq_cutoff(freq_cutoff), m_pass_ripple(ripple){
-            auto [b, a] = calc_coeff_biq(freq_cutoff, ripple);
-            this->set_coeff(b, a);
+        ChebyshevLowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, double ripple) : SOS<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff), m_pass_ripple(ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            this->set_coeff(design.coeff_b);
         }
 
         /**
-         * @brief Method for calculating biquad filter coeffitients.
+         * @brief Method for calculating second order sections of filter (see iir_sos_coeff()).
          * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
-         * @param freq_cutoff Double type lower cutoff frequency.
-         * @param ripple Double type passband ripple of filter.
-         * @return Returns pair of coeffitients vectors in type of setting in object constructor.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if parameters are not valid.
+         */
+        std::vector<T> calc_coeff_sos(int order, double freq_cutoff, double ripple){
+            return iir_sos_coeff<T>(IIR_Prototype::Chebyshev1, this->get_sampling_freq(), order, freq_cutoff, ripple, false);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
+         * @return Returns true if succesful, false if parameters are not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(int order, double freq_cutoff, double ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->set_coeff(design.coeff_b)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, double ripple, std::size_t crossfade = 0){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->request_coeff(design.coeff_b, crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<ChebyshevLowpass<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter.
+         */
+        int get_order() const{
+            return m_order;
+        }
+        
+        /**
+         * @brief Getter of the object cutoff frequency.
+         * @return Returns Double type cutoff frequency.
          */
-        std::pair<std::vector<T>, std::vector<T>> calc_coeff_biq(double freq_cutoff, double ripple){    
+        double get_freq_cutoff() const{
+            return m_freq_cutoff;
+        }
+
+    };
+
+    /**
+     * @brief ChebyshevHighpass filter class is used to calculate chebyschev 1 type highpass coeffitients of given order and set them as second order sections.
+     * * Class hold order of the filter, cutoff frequency, ripple and methods for calucating coeffitients and updateing filter runing.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class ChebyshevHighpass : public SOS<T> {
+        private:
+            int m_order;
+            double m_freq_cutoff;
+            double m_pass_ripple;
 
-            double fs = this->get_sampling_freq();
-            double epsilon = std::sqrt(std::pow(10.0, ripple / 10.0) - 1.0);
-            double v = (1.0 / 2.0) * std::asinh(1.0 / epsilon);
-            double k = std::tan(M_PI * freq_cutoff / fs);
-            double k2 = k * k;
+            /**
+             * @brief Helper returning sections from Design_Cache, calculated by calc_coeff_sos() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @param ripple Double type passband ripple of filter in dB.
+             * @return Returns shared sections in coeffitients b.
+             */
+            Design_Entry<T> cached_coeff(int order, double freq_cutoff, double ripple){
+                Design_Key key{Design_Type::ChebyshevHighpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, ripple};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff_sos(order, freq_cutoff, ripple)), Shared_Coeff<T>()};
+                });
+            }
 
-            double s_re = -std::sinh(v) * std::sin(M_PI / 4.0);
-            double s_im = std::cosh(v) * std::cos(M_PI / 4.0);
-            double a_sq = s_re * s_re + s_im * s_im;
-            double a0 = k2 - 2.0 * s_re * k + a_sq;
+        public:
 
-            std::vector<T> b= {static_cast<T>(k2/a0), static_cast<T>(2.0*k2/a0), static_cast<T>(k2 / a0)};
-            std::vector<T> a = {static_cast<T>(2.0 * (k2 - a_sq) / a0), static_cast<T>((k2 + 2.0 * s_re * k + a_sq) / a0)};
+        /**
+        * @brief Deafault constructor of ChebyshevHighpass object.
+        * * Designs filter of order 2, cutoff 2250 Hz, ripple 1 dB at sampling frequency 44100 Hz.
+        */
+        ChebyshevHighpass() : ChebyshevHighpass(44100.0, "ChebyshevHighpass", 2, 2250.0, 1.0) {}
 
-            double gain_fix = 1.0 / std::sqrt(1.0 + epsilon * epsilon);
-            for(auto& val : b){
-                val *= static_cast<T>(gain_fix);
-            } 
+        /**
+         * @brief Parametric construcotr of ChebyshevHighpass filter object.
+         * * Filter without valid design (order below 1, cutoff outside 0 - sampling_freq / 2) has no sections and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter (odd order adds first order section).
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
+         */
+        ChebyshevHighpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, double ripple) : SOS<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff), m_pass_ripple(ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            this->set_coeff(design.coeff_b);
+        }
 
-            return {b, a};
+        /**
+         * @brief Method for calculating second order sections of filter (see iir_sos_coeff()).
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if parameters are not valid.
+         */
+        std::vector<T> calc_coeff_sos(int order, double freq_cutoff, double ripple){
+            return iir_sos_coeff<T>(IIR_Prototype::Chebyshev1, this->get_sampling_freq(), order, freq_cutoff, ripple, true);
         }
 
         /**
          * @brief Method (setter) used to calculate and set filter coeffitients.
          * @param order Integer type order of filter.
          * @param freq_cutoff Double type cutoff frequency.
-         * @return Returns true if succesful. False otherwise.
+         * @param ripple Double type passband ripple of filter in dB.
+         * @return Returns true if succesful, false if parameters are not valid (filter and it's parameters are unchanged).
          */
-        void upadate_coeffs(int order, double freq_cutoff, double ripple){
+        bool upadate_coeffs(int order, double freq_cutoff, double ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->set_coeff(design.coeff_b)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type passband ripple of filter in dB.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, double ripple, std::size_t crossfade = 0){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->request_coeff(design.coeff_b, crossfade)) {
+                return false;
+            }
             m_order = order;
             m_freq_cutoff = freq_cutoff;
             m_pass_ripple = ripple;
-            auto [b, a] = calc_coeff_biq(freq_cutoff, ripple);
-            this->set_coeff(b, a);
+            return true;
         }
 
         /**
         * @brief Method for cloning it's self - used to make cascades
         */
         std::unique_ptr<Base_Filter<T>> clone() const override {
-            return std::make_unique<ChebyshevLowpass<T>>(*this);
+            return std::make_unique<ChebyshevHighpass<T>>(*this);
         }
 
         /**
@@ -108,103 +253,346 @@ namespace af{
     };
 
     /**
-     * @brief ChebyshevHighpass filter class is used to calculate chebyschev 1 type highpass coeffitiens for biquad filter and set them. 
-     * * Class hold order(not used) of the filter, cutoff frequencies, passband ripple and methods for calucating coeffitients and updateing filter runing.
+     * @brief Chebyshev2Lowpass filter class is used to calculate chebyschev 2 type (inverse, cutoff is start of stopband) lowpass coeffitients of given order and set them as second order sections.
+     * * Class hold order of the filter, cutoff frequency, ripple and methods for calucating coeffitients and updateing filter runing.
      * @tparam T is sample input type numeric data.
-     */ 
+     */
     template <typename T>
-    class ChebyshevHighpass : public IIR<T> {
+    class Chebyshev2Lowpass : public SOS<T> {
         private:
             int m_order;
             double m_freq_cutoff;
             double m_pass_ripple;
 
+            /**
+             * @brief Helper returning sections from Design_Cache, calculated by calc_coeff_sos() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @param ripple Double type stopband attenuation of filter in dB.
+             * @return Returns shared sections in coeffitients b.
+             */
+            Design_Entry<T> cached_coeff(int order, double freq_cutoff, double ripple){
+                Design_Key key{Design_Type::Chebyshev2Lowpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, ripple};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff_sos(order, freq_cutoff, ripple)), Shared_Coeff<T>()};
+                });
+            }
+
         public:
 
         /**
-        * @brief Deafault constructor of ChebyshevHighpass object. 
-        * * Sets basic values for allpass filter.
+        * @brief Deafault constructor of Chebyshev2Lowpass object.
+        * * Designs filter of order 2, cutoff 2250 Hz, stopband attenuation 1 dB at sampling frequency 44100 Hz.
         */
-        ChebyshevHighpass() : IIR<T>(44100.0, "Chebychev Lowpass", {0,1,0}, {0,0}), m_order(2), m_freq_cutoff(2250.0) {}
+        Chebyshev2Lowpass() : Chebyshev2Lowpass(44100.0, "Chebyshev2Lowpass", 2, 2250.0, 1.0) {}
 
         /**
-         * @brief Parametric construcotr of ChebyshevHighpass filter object.
+         * @brief Parametric construcotr of Chebyshev2Lowpass filter object.
+         * * Filter without valid design (order below 1, cutoff outside 0 - sampling_freq / 2) has no sections and passes samples unchanged.
          * @param sampling_freq Double type Sampling frequency if signal input.
          * @param filter_name String type Name of filter.
-         * @param order Integer type order of filter.
-         * @param freq_cutoff Double type lower cutoff frequency.
-         * @param ripple Double type passband ripple of filter. 
+         * @param order Integer type order of filter (odd order adds first order section).
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
          */
-        ChebyshevHighpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, double ripple) :  IIR<T>(sampling_freq, filter_name, {0,1,0}, {0,0}), m_order(order), m_freq_cutoff(freq_cutoff), m_pass_ripple(ripple){
-            auto [b, a] = calc_coeff_biq(freq_cutoff, ripple);
-            this->set_coeff(b, a);
+        Chebyshev2Lowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, double ripple) : SOS<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff), m_pass_ripple(ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            this->set_coeff(design.coeff_b);
         }
 
         /**
-         * @brief Method for calculating biquad filter coeffitients.
+         * @brief Method for calculating second order sections of filter (see iir_sos_coeff()).
          * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
-         * @param freq_cutoff Double type lower cutoff frequency.
-         * @param ripple Double type passband ripple of filter.
-         * @return Returns pair of coeffitients vectors in type of setting in object constructor.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if parameters are not valid.
+         */
+        std::vector<T> calc_coeff_sos(int order, double freq_cutoff, double ripple){
+            return iir_sos_coeff<T>(IIR_Prototype::Chebyshev2, this->get_sampling_freq(), order, freq_cutoff, ripple, false);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         * @return Returns true if succesful, false if parameters are not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(int order, double freq_cutoff, double ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->set_coeff(design.coeff_b)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, double ripple, std::size_t crossfade = 0){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->request_coeff(design.coeff_b, crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<Chebyshev2Lowpass<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter.
          */
-        std::pair<std::vector<T>, std::vector<T>> calc_coeff_biq(double freq_cutoff, double ripple){    
+        int get_order() const{
+            return m_order;
+        }
         
-            double fs = this->get_sampling_freq();
+        /**
+         * @brief Getter of the object cutoff frequency.
+         * @return Returns Double type cutoff frequency.
+         */
+        double get_freq_cutoff() const{
+            return m_freq_cutoff;
+        }
 
-            if (freq_cutoff <= 0){
-                freq_cutoff = 1.0;
-            } 
+    };
+
+    /**
+     * @brief Chebyshev2Highpass filter class is used to calculate chebyschev 2 type (inverse, cutoff is start of stopband) highpass coeffitients of given order and set them as second order sections.
+     * * Class hold order of the filter, cutoff frequency, ripple and methods for calucating coeffitients and updateing filter runing.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class Chebyshev2Highpass : public SOS<T> {
+        private:
+            int m_order;
+            double m_freq_cutoff;
+            double m_pass_ripple;
 
-            if (freq_cutoff >= fs / 2.0){
-                freq_cutoff = fs / 2.0 - 1.0;
+            /**
+             * @brief Helper returning sections from Design_Cache, calculated by calc_coeff_sos() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @param ripple Double type stopband attenuation of filter in dB.
+             * @return Returns shared sections in coeffitients b.
+             */
+            Design_Entry<T> cached_coeff(int order, double freq_cutoff, double ripple){
+                Design_Key key{Design_Type::Chebyshev2Highpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, ripple};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff_sos(order, freq_cutoff, ripple)), Shared_Coeff<T>()};
+                });
             }
 
-            double epsilon = std::sqrt(std::pow(10.0, ripple / 10.0) - 1.0);
-            double v = (1.0 / 2.0) * std::asinh(1.0 / epsilon); 
-            double k = std::tan(M_PI * freq_cutoff / fs);
-            double k2 = k * k;
-            
-            double s_re = -std::sinh(v) * std::sin(M_PI / 4.0);
-            double s_im = std::cosh(v) * std::cos(M_PI / 4.0);
-            double a_sq = s_re * s_re + s_im * s_im;
-            double a0 = a_sq * k2 - 2.0 * s_re * k + 1.0;
+        public:
+
+        /**
+        * @brief Deafault constructor of Chebyshev2Highpass object.
+        * * Designs filter of order 2, cutoff 2250 Hz, stopband attenuation 1 dB at sampling frequency 44100 Hz.
+        */
+        Chebyshev2Highpass() : Chebyshev2Highpass(44100.0, "Chebyshev2Highpass", 2, 2250.0, 1.0) {}
 
-            double b0 = 1.0 / a0;
-            double b1 = -2.0 / a0;
-            double b2 = 1.0 / a0;
+        /**
+         * @brief Parametric construcotr of Chebyshev2Highpass filter object.
+         * * Filter without valid design (order below 1, cutoff outside 0 - sampling_freq / 2) has no sections and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter (odd order adds first order section).
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         */
+        Chebyshev2Highpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff, double ripple) : SOS<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff), m_pass_ripple(ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            this->set_coeff(design.coeff_b);
+        }
 
-            double gain_fix = 1.0 / std::sqrt(1.0 + epsilon * epsilon);
-            b0 *= gain_fix;
-            b1 *= gain_fix;
-            b2 *= gain_fix;
+        /**
+         * @brief Method for calculating second order sections of filter (see iir_sos_coeff()).
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if parameters are not valid.
+         */
+        std::vector<T> calc_coeff_sos(int order, double freq_cutoff, double ripple){
+            return iir_sos_coeff<T>(IIR_Prototype::Chebyshev2, this->get_sampling_freq(), order, freq_cutoff, ripple, true);
+        }
 
-            std::vector<T> b = {static_cast<T>(b0), static_cast<T>(b1), static_cast<T>(b2) };
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         * @return Returns true if succesful, false if parameters are not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(int order, double freq_cutoff, double ripple){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->set_coeff(design.coeff_b)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
 
-            std::vector<T> a = {static_cast<T>(2.0 * (a_sq * k2 - 1.0) / a0), static_cast<T>((a_sq * k2 + 2.0 * s_re * k + 1.0) / a0)};
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param ripple Double type stopband attenuation of filter in dB.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, double ripple, std::size_t crossfade = 0){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff, ripple);
+            if (!this->request_coeff(design.coeff_b, crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            m_pass_ripple = ripple;
+            return true;
+        }
 
-            return {b, a};
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<Chebyshev2Highpass<T>>(*this);
+        }
 
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter.
+         */
+        int get_order() const{
+            return m_order;
         }
         
+        /**
+         * @brief Getter of the object cutoff frequency.
+         * @return Returns Double type cutoff frequency.
+         */
+        double get_freq_cutoff() const{
+            return m_freq_cutoff;
+        }
+
+    };
+
+    /**
+     * @brief ButterworthLowpass filter class is used to calculate butterworth lowpass coeffitients of given order and set them as second order sections.
+     * * Class hold order of the filter, cutoff frequency and methods for calucating coeffitients and updateing filter runing.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class ButterworthLowpass : public SOS<T> {
+        private:
+            int m_order;
+            double m_freq_cutoff;
+
+            /**
+             * @brief Helper returning sections from Design_Cache, calculated by calc_coeff_sos() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @return Returns shared sections in coeffitients b.
+             */
+            Design_Entry<T> cached_coeff(int order, double freq_cutoff){
+                Design_Key key{Design_Type::ButterworthLowpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, 0.0};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff_sos(order, freq_cutoff)), Shared_Coeff<T>()};
+                });
+            }
+
+        public:
+
+        /**
+        * @brief Deafault constructor of ButterworthLowpass object.
+        * * Designs filter of order 2, cutoff 2250 Hz at sampling frequency 44100 Hz.
+        */
+        ButterworthLowpass() : ButterworthLowpass(44100.0, "ButterworthLowpass", 2, 2250.0) {}
+
+        /**
+         * @brief Parametric construcotr of ButterworthLowpass filter object.
+         * * Filter without valid design (order below 1, cutoff outside 0 - sampling_freq / 2) has no sections and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter (odd order adds first order section).
+         * @param freq_cutoff Double type cutoff frequency.
+         */
+        ButterworthLowpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff) : SOS<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff);
+            this->set_coeff(design.coeff_b);
+        }
+
+        /**
+         * @brief Method for calculating second order sections of filter (see iir_sos_coeff()).
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if parameters are not valid.
+         */
+        std::vector<T> calc_coeff_sos(int order, double freq_cutoff){
+            return iir_sos_coeff<T>(IIR_Prototype::Butterworth, this->get_sampling_freq(), order, freq_cutoff, 0.0, false);
+        }
+
         /**
          * @brief Method (setter) used to calculate and set filter coeffitients.
          * @param order Integer type order of filter.
          * @param freq_cutoff Double type cutoff frequency.
-         * @return Returns true if succesful. False otherwise.
+         * @return Returns true if succesful, false if parameters are not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(int order, double freq_cutoff){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff);
+            if (!this->set_coeff(design.coeff_b)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients.
+         * @return Returns true if request was published. False otherwise.
          */
-        void upadate_coeffs(int order, double freq_cutoff, double ripple){
+        bool request_coeffs(int order, double freq_cutoff, std::size_t crossfade = 0){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff);
+            if (!this->request_coeff(design.coeff_b, crossfade)) {
+                return false;
+            }
             m_order = order;
             m_freq_cutoff = freq_cutoff;
-            m_pass_ripple = ripple;
-            auto [b, a] = calc_coeff_biq(freq_cutoff, ripple);
-            this->set_coeff(b, a);
+            return true;
         }
 
         /**
         * @brief Method for cloning it's self - used to make cascades
         */
         std::unique_ptr<Base_Filter<T>> clone() const override {
-            return std::make_unique<ChebyshevHighpass<T>>(*this);
+            return std::make_unique<ButterworthLowpass<T>>(*this);
         }
 
         /**
@@ -222,7 +610,490 @@ namespace af{
         double get_freq_cutoff() const{
             return m_freq_cutoff;
         }
-            
+
     };
-    
-}
\ No newline at end of file
+
+    /**
+     * @brief ButterworthHighpass filter class is used to calculate butterworth highpass coeffitients of given order and set them as second order sections.
+     * * Class hold order of the filter, cutoff frequency and methods for calucating coeffitients and updateing filter runing.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class ButterworthHighpass : public SOS<T> {
+        private:
+            int m_order;
+            double m_freq_cutoff;
+
+            /**
+             * @brief Helper returning sections from Design_Cache, calculated by calc_coeff_sos() on miss.
+             * @param order Integer type order of filter.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @return Returns shared sections in coeffitients b.
+             */
+            Design_Entry<T> cached_coeff(int order, double freq_cutoff){
+                Design_Key key{Design_Type::ButterworthHighpass, this->get_sampling_freq(), order, freq_cutoff, 0.0, 0.0};
+                return Design_Cache<T>::instance().get(key, [&] {
+                    return Design_Entry<T>{Shared_Coeff<T>(calc_coeff_sos(order, freq_cutoff)), Shared_Coeff<T>()};
+                });
+            }
+
+        public:
+
+        /**
+        * @brief Deafault constructor of ButterworthHighpass object.
+        * * Designs filter of order 2, cutoff 2250 Hz at sampling frequency 44100 Hz.
+        */
+        ButterworthHighpass() : ButterworthHighpass(44100.0, "ButterworthHighpass", 2, 2250.0) {}
+
+        /**
+         * @brief Parametric construcotr of ButterworthHighpass filter object.
+         * * Filter without valid design (order below 1, cutoff outside 0 - sampling_freq / 2) has no sections and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param order Integer type order of filter (odd order adds first order section).
+         * @param freq_cutoff Double type cutoff frequency.
+         */
+        ButterworthHighpass(double sampling_freq, std::string filter_name, int order, double freq_cutoff) : SOS<T>(sampling_freq, filter_name), m_order(order), m_freq_cutoff(freq_cutoff){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff);
+            this->set_coeff(design.coeff_b);
+        }
+
+        /**
+         * @brief Method for calculating second order sections of filter (see iir_sos_coeff()).
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if parameters are not valid.
+         */
+        std::vector<T> calc_coeff_sos(int order, double freq_cutoff){
+            return iir_sos_coeff<T>(IIR_Prototype::Butterworth, this->get_sampling_freq(), order, freq_cutoff, 0.0, true);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @return Returns true if succesful, false if parameters are not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(int order, double freq_cutoff){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff);
+            if (!this->set_coeff(design.coeff_b)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * * Coeffitients are calculated on the calling (control) thread, filtering thread does not allocate.
+         * @param order Integer type order of filter.
+         * @param freq_cutoff Double type cutoff frequency.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients.
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(int order, double freq_cutoff, std::size_t crossfade = 0){
+            Design_Entry<T> design = cached_coeff(order, freq_cutoff);
+            if (!this->request_coeff(design.coeff_b, crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_freq_cutoff = freq_cutoff;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<ButterworthHighpass<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter.
+         */
+        int get_order() const{
+            return m_order;
+        }
+        
+        /**
+         * @brief Getter of the object cutoff frequency.
+         * @return Returns Double type cutoff frequency.
+         */
+        double get_freq_cutoff() const{
+            return m_freq_cutoff;
+        }
+
+    };
+
+    /**
+     * @brief EllipticLowpass filter class is used to calculate elliptic (Cauer) lowpass of minimal order meeting the specification
+     * * and set it as second order sections (see elliptic_lowpass_coeff()).
+     * * Elliptic design has ripple in both bands and needs the lowest order of all IIR designs for given specification.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class EllipticLowpass : public SOS<T> {
+        private:
+            int m_order;
+            IIR_Spec m_spec;
+
+        public:
+
+        /**
+         * @brief Parametric construcotr of EllipticLowpass filter object.
+         * * Filter with invalid specification has no sections, order 0 and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         */
+        EllipticLowpass(double sampling_freq, std::string filter_name, const IIR_Spec& spec) : SOS<T>(sampling_freq, filter_name), m_order(0), m_spec(spec){
+            this->set_coeff(calc_coeff_sos(spec, &m_order));
+        }
+
+        /**
+         * @brief Method for calculating second order sections of filter.
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param order Optional pointer filled with order of design.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if specification is not valid.
+         */
+        std::vector<T> calc_coeff_sos(const IIR_Spec& spec, int* order = nullptr){
+            return elliptic_lowpass_coeff<T>(this->get_sampling_freq(), spec, order);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @return Returns true if succesful, false if specification is not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(const IIR_Spec& spec){
+            int order = 0;
+            if (!this->set_coeff(calc_coeff_sos(spec, &order))) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients (used only if order is unchanged).
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(const IIR_Spec& spec, std::size_t crossfade = 0){
+            int order = 0;
+            if (!this->request_coeff(calc_coeff_sos(spec, &order), crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<EllipticLowpass<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter, 0 if specification is invalid.
+         */
+        int get_order() const{
+            return m_order;
+        }
+
+        /**
+         * @brief Getter of the object specification.
+         * @return Returns specification the filter was designed for.
+         */
+        const IIR_Spec& get_spec() const{
+            return m_spec;
+        }
+
+    };
+
+    /**
+     * @brief EllipticHighpass filter class is used to calculate elliptic (Cauer) highpass of minimal order meeting the specification
+     * * and set it as second order sections (see elliptic_highpass_coeff()).
+     * * Elliptic design has ripple in both bands and needs the lowest order of all IIR designs for given specification.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class EllipticHighpass : public SOS<T> {
+        private:
+            int m_order;
+            IIR_Spec m_spec;
+
+        public:
+
+        /**
+         * @brief Parametric construcotr of EllipticHighpass filter object.
+         * * Filter with invalid specification has no sections, order 0 and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         */
+        EllipticHighpass(double sampling_freq, std::string filter_name, const IIR_Spec& spec) : SOS<T>(sampling_freq, filter_name), m_order(0), m_spec(spec){
+            this->set_coeff(calc_coeff_sos(spec, &m_order));
+        }
+
+        /**
+         * @brief Method for calculating second order sections of filter.
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param order Optional pointer filled with order of design.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if specification is not valid.
+         */
+        std::vector<T> calc_coeff_sos(const IIR_Spec& spec, int* order = nullptr){
+            return elliptic_highpass_coeff<T>(this->get_sampling_freq(), spec, order);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @return Returns true if succesful, false if specification is not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(const IIR_Spec& spec){
+            int order = 0;
+            if (!this->set_coeff(calc_coeff_sos(spec, &order))) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients (used only if order is unchanged).
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(const IIR_Spec& spec, std::size_t crossfade = 0){
+            int order = 0;
+            if (!this->request_coeff(calc_coeff_sos(spec, &order), crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<EllipticHighpass<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter, 0 if specification is invalid.
+         */
+        int get_order() const{
+            return m_order;
+        }
+
+        /**
+         * @brief Getter of the object specification.
+         * @return Returns specification the filter was designed for.
+         */
+        const IIR_Spec& get_spec() const{
+            return m_spec;
+        }
+
+    };
+
+    /**
+     * @brief EllipticBandpass filter class is used to calculate elliptic (Cauer) bandpass of minimal order meeting the specification
+     * * and set it as second order sections (see elliptic_bandpass_coeff()).
+     * * Elliptic design has ripple in both bands and needs the lowest order of all IIR designs for given specification.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class EllipticBandpass : public SOS<T> {
+        private:
+            int m_order;
+            IIR_Band_Spec m_spec;
+
+        public:
+
+        /**
+         * @brief Parametric construcotr of EllipticBandpass filter object.
+         * * Filter with invalid specification has no sections, order 0 and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         */
+        EllipticBandpass(double sampling_freq, std::string filter_name, const IIR_Band_Spec& spec) : SOS<T>(sampling_freq, filter_name), m_order(0), m_spec(spec){
+            this->set_coeff(calc_coeff_sos(spec, &m_order));
+        }
+
+        /**
+         * @brief Method for calculating second order sections of filter.
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param order Optional pointer filled with order of design.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if specification is not valid.
+         */
+        std::vector<T> calc_coeff_sos(const IIR_Band_Spec& spec, int* order = nullptr){
+            return elliptic_bandpass_coeff<T>(this->get_sampling_freq(), spec, order);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @return Returns true if succesful, false if specification is not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(const IIR_Band_Spec& spec){
+            int order = 0;
+            if (!this->set_coeff(calc_coeff_sos(spec, &order))) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients (used only if order is unchanged).
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(const IIR_Band_Spec& spec, std::size_t crossfade = 0){
+            int order = 0;
+            if (!this->request_coeff(calc_coeff_sos(spec, &order), crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<EllipticBandpass<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter, 0 if specification is invalid.
+         */
+        int get_order() const{
+            return m_order;
+        }
+
+        /**
+         * @brief Getter of the object specification.
+         * @return Returns specification the filter was designed for.
+         */
+        const IIR_Band_Spec& get_spec() const{
+            return m_spec;
+        }
+
+    };
+
+    /**
+     * @brief EllipticBandstop filter class is used to calculate elliptic (Cauer) bandstop of minimal order meeting the specification
+     * * and set it as second order sections (see elliptic_bandstop_coeff()).
+     * * Elliptic design has ripple in both bands and needs the lowest order of all IIR designs for given specification.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class EllipticBandstop : public SOS<T> {
+        private:
+            int m_order;
+            IIR_Band_Spec m_spec;
+
+        public:
+
+        /**
+         * @brief Parametric construcotr of EllipticBandstop filter object.
+         * * Filter with invalid specification has no sections, order 0 and passes samples unchanged.
+         * @param sampling_freq Double type Sampling frequency if signal input.
+         * @param filter_name String type Name of filter.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         */
+        EllipticBandstop(double sampling_freq, std::string filter_name, const IIR_Band_Spec& spec) : SOS<T>(sampling_freq, filter_name), m_order(0), m_spec(spec){
+            this->set_coeff(calc_coeff_sos(spec, &m_order));
+        }
+
+        /**
+         * @brief Method for calculating second order sections of filter.
+         * * Method takes in parameters and only calculate coeffitnients of filter, does not set them to a object.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param order Optional pointer filled with order of design.
+         * @return Returns vector of sections b0, b1, b2, a1, a2, empty if specification is not valid.
+         */
+        std::vector<T> calc_coeff_sos(const IIR_Band_Spec& spec, int* order = nullptr){
+            return elliptic_bandstop_coeff<T>(this->get_sampling_freq(), spec, order);
+        }
+
+        /**
+         * @brief Method (setter) used to calculate and set filter coeffitients.
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @return Returns true if succesful, false if specification is not valid (filter and it's parameters are unchanged).
+         */
+        bool upadate_coeffs(const IIR_Band_Spec& spec){
+            int order = 0;
+            if (!this->set_coeff(calc_coeff_sos(spec, &order))) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+         * @brief Method used to calculate coeffitients and request glitch-free swap at next block boundary (see SOS::request_coeff()).
+         * @param spec Edges, passband ripple and stopband attenuation.
+         * @param crossfade Number of samples for interpolation between old and new coeffitients (used only if order is unchanged).
+         * @return Returns true if request was published. False otherwise.
+         */
+        bool request_coeffs(const IIR_Band_Spec& spec, std::size_t crossfade = 0){
+            int order = 0;
+            if (!this->request_coeff(calc_coeff_sos(spec, &order), crossfade)) {
+                return false;
+            }
+            m_order = order;
+            m_spec = spec;
+            return true;
+        }
+
+        /**
+        * @brief Method for cloning it's self - used to make cascades
+        */
+        std::unique_ptr<Base_Filter<T>> clone() const override {
+            return std::make_unique<EllipticBandstop<T>>(*this);
+        }
+
+        /**
+         * @brief Getter of the object order.
+         * @return Returns integer type order of the filter, 0 if specification is invalid.
+         */
+        int get_order() const{
+            return m_order;
+        }
+
+        /**
+         * @brief Getter of the object specification.
+         * @return Returns specification the filter was designed for.
+         */
+        const IIR_Band_Spec& get_spec() const{
+            return m_spec;
+        }
+
+    };
+
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "base_filter.hpp"
+#include "response.hpp"
+#include <algorithm>
+
+namespace af{
+
+    /**
+     * @brief Response type of state variable filter.
+     */
+    enum class SVF_Mode { Lowpass, Highpass, Bandpass, Notch };
+
+    /**
+     * @brief StateVariable class is a topology preserving transform (TPT) state variable filter.
+     * * Filter is stable under fast modulation - cutoff can be changed every sample without clicks.
+     * * Changing cutoff costs one rational tan approximation and one division, no allocation.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class StateVariable : public Base_Filter<T> {
+        private:
+            SVF_Mode m_mode;
+            double m_freq_cutoff;
+            double m_q;
+            T m_pi_over_fs;
+            T m_k;
+            T m_a1;
+            T m_a2;
+            T m_a3;
+            T m_ic1eq;
+            T m_ic2eq;
+
+            /**
+             * @brief Helper calculating coeffitients from prewarped cutoff.
+             * @param g Prewarped cutoff tan(pi * fc / fs).
+             */
+            void set_g(T g){
+                m_a1 = static_cast<T>(1) / (static_cast<T>(1) + g * (g + m_k));
+                m_a2 = g * m_a1;
+                m_a3 = g * m_a2;
+            }
+
+            /**
+             * @brief Helper calculating prewarped cutoff for cutoff frequency in Hz (clamped below Nyquist).
+             * @param freq_cutoff Cutoff frequency in Hz.
+             * @return Returns tan(pi * fc / fs).
+             */
+            T prewarp(T freq_cutoff) const{
+                T x = freq_cutoff * m_pi_over_fs;
+                const T x_max = static_cast<T>(M_PI * 0.499);
+
+                if (x < static_cast<T>(0)){
+                    x = static_cast<T>(0);
+                }
+
+                if (x > x_max){
+                    x = x_max;
+                }
+
+                return fast_tan(x);
+            }
+
+            /**
+             * @brief Helper processing one sample with current coeffitients.
+             * @param input Numerical type input sample.
+             * @return Returns output of selected response type.
+             */
+            T tick(T input){
+                T v3 = input - m_ic2eq;
+                T v1 = m_a1 * m_ic1eq + m_a2 * v3;
+                T v2 = m_ic2eq + m_a2 * m_ic1eq + m_a3 * v3;
+                m_ic1eq = static_cast<T>(2) * v1 - m_ic1eq;
+                m_ic2eq = static_cast<T>(2) * v2 - m_ic2eq;
+
+                if (this->get_flush_denormals()){
+                    m_ic1eq = flush_tiny(m_ic1eq);
+                    m_ic2eq = flush_tiny(m_ic2eq);
+                }
+
+                switch (m_mode){
+                    case SVF_Mode::Lowpass:
+                        return v2;
+                    case SVF_Mode::Highpass:
+                        return input - m_k * v1 - v2;
+                    case SVF_Mode::Bandpass:
+                        return v1;
+                    default:
+                        return input - m_k * v1;
+                }
+            }
+
+            /**
+             * @brief Helper calculating equivalent biquad of current settings (bilinear transform of analog state variable filter).
+             * @param b Filled with numerator coeffitients b0, b1, b2.
+             * @param a Filled with denominator coeffitients a1, a2 (a0 = 1).
+             */
+            void biquad(double b[3], double a[2]) const{
+                const double g = std::tan(M_PI * std::min(m_freq_cutoff / this->get_sampling_freq(), 0.499));
+                const double k = 1.0 / m_q;
+                const double a0 = 1.0 + k * g + g * g;
+
+                a[0] = (2.0 * g * g - 2.0) / a0;
+                a[1] = (1.0 - k * g + g * g) / a0;
+                switch (m_mode){
+                    case SVF_Mode::Lowpass:
+                        b[0] = g * g / a0;
+                        b[1] = 2.0 * b[0];
+                        b[2] = b[0];
+                        break;
+                    case SVF_Mode::Highpass:
+                        b[0] = 1.0 / a0;
+                        b[1] = -2.0 * b[0];
+                        b[2] = b[0];
+                        break;
+                    case SVF_Mode::Bandpass:
+                        b[0] = g / a0;
+                        b[1] = 0.0;
+                        b[2] = -b[0];
+                        break;
+                    default:
+                        b[0] = (1.0 + g * g) / a0;
+                        b[1] = a[0];
+                        b[2] = b[0];
+                        break;
+                }
+            }
+
+        protected:
+
+            /**
+             * @brief Writes integrator states and current coeffitients as binary state (see Base_Filter::save_state()).
+             * * Coeffitients are part of the state, because cutoff may be modulated every sample.
+             * @param buffer Pointer to state buffer of at least state_size() bytes.
+             * @return Returns number of written bytes.
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                const T values[5] = {m_ic1eq, m_ic2eq, m_a1, m_a2, m_a3};
+                unsigned char* position = state_put_count(buffer, 5);
+                position = state_put(position, values, 5);
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads integrator states and current coeffitients from binary state (see Base_Filter::load_state()).
+             * @param buffer Pointer to state buffer.
+             * @param size Number of bytes available in buffer.
+             * @return Returns number of read bytes, 0 if state is invalid.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                T values[5];
+
+                if (!state_get_count(position, buffer + size, 5) || !state_get(position, buffer + size, values, 5)){
+                    return 0;
+                }
+
+                m_ic1eq = values[0];
+                m_ic2eq = values[1];
+                m_a1 = values[2];
+                m_a2 = values[3];
+                m_a3 = values[4];
+                return position - buffer;
+            }
+
+        public:
+
+            /**
+             * @brief Deafault constructor of StateVariable object.
+             * * Sets basic values for lowpass with cutoff 2250Hz and Butterworth Q.
+             */
+            StateVariable() : StateVariable(44100.0, "State Variable", SVF_Mode::Lowpass, 2250.0, M_SQRT1_2) {}
+
+            /**
+             * @brief Parametric constructor of StateVariable filter object.
+             * @param sampling_freq Double type Sampling frequency if signal input.
+             * @param filter_name String type Name of filter.
+             * @param mode Response type (lowpass, highpass, bandpass or notch).
+             * @param freq_cutoff Double type cutoff (center) frequency.
+             * @param q Double type quality factor. Must be greater than 0.
+             */
+            StateVariable(double sampling_freq, std::string filter_name, SVF_Mode mode, double freq_cutoff, double q) : Base_Filter<T>(sampling_freq, filter_name), m_mode(mode), m_freq_cutoff(freq_cutoff), m_q(M_SQRT1_2), m_ic1eq(0), m_ic2eq(0) {
+                m_pi_over_fs = static_cast<T>(M_PI / this->get_sampling_freq());
+
+                if (!set_q(q)){
+                    set_q(M_SQRT1_2);
+                }
+            }
+
+            /**
+             * @brief Rational (Pade 7/6) approximation of tangent, relative error below 1e-6 up to 0.499 of Nyquist.
+             * @param x Angle in radians from range [0, pi/2).
+             * @return Returns approximation of tan(x).
+             */
+            static T fast_tan(T x){
+                T x2 = x * x;
+                T num = x * (static_cast<T>(135135) - x2 * (static_cast<T>(17325) - x2 * (static_cast<T>(378) - x2)));
+                T den = static_cast<T>(135135) - x2 * (static_cast<T>(62370) - x2 * (static_cast<T>(3150) - static_cast<T>(28) * x2));
+                return num / den;
+            }
+
+            /**
+             * @brief Setter of cutoff frequency. Cheap enough to be called every sample, keeps filter state.
+             * @param freq_cutoff Double type cutoff frequency.
+             * @return Returns true if setting succesful, otherwise false. (frequency must be in range (0, fs/2))
+             */
+            bool set_freq_cutoff(double freq_cutoff){
+                if (freq_cutoff <= 0 || freq_cutoff >= this->get_sampling_freq() / 2.0){
+                    return false;
+                }
+
+                m_freq_cutoff = freq_cutoff;
+                set_g(prewarp(static_cast<T>(freq_cutoff)));
+                return true;
+            }
+
+            /**
+             * @brief Setter of quality factor. Keeps filter state.
+             * @param q Double type quality factor.
+             * @return Returns true if setting succesful, otherwise false. (q must be greater than 0)
+             */
+            bool set_q(double q){
+                if (q <= 0){
+                    return false;
+                }
+
+                m_q = q;
+                m_k = static_cast<T>(1.0 / q);
+                set_g(prewarp(static_cast<T>(m_freq_cutoff)));
+                return true;
+            }
+
+            /**
+             * @brief Setter of response type. Keeps filter state, so mode can be switched while running.
+             * @param mode Response type of the filter.
+             */
+            void set_mode(SVF_Mode mode){
+                m_mode = mode;
+            }
+
+            /**
+             * @brief Method for filtering a sample of input signal with current cutoff.
+             * @tparam Numerical type input sample.
+             * @return Filtered numerical type input sample (same as input type).
+             */
+            T filter(T input) override{
+                AF_RT_SCOPE();
+                return tick(input);
+            }
+
+            /**
+             * @brief Method for filtering a block of samples with current cutoff.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+
+                for (std::size_t i = 0; i < length; i++){
+                    output[i] = tick(input[i]);
+                }
+            }
+
+            /**
+             * @brief Method for filtering in place one channel of strided buffer with current cutoff.
+             * @param data Pointer to first sample of the channel.
+             * @param stride Distance between samples of the channel.
+             * @param length Number of samples of the channel.
+             */
+            void filter_block_strided(T* data, std::size_t stride, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+
+                for (std::size_t i = 0; i < length; i++, data += stride){
+                    *data = tick(*data);
+                }
+            }
+
+            /**
+             * @brief Method for filtering a block of samples with cutoff modulated every sample.
+             * * Cutoff values outside (0, fs/2) are clamped. After the call filter keeps last cutoff of the block.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param freq_cutoff Pointer to block of cutoff frequencies in Hz, one for each sample.
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, const T* freq_cutoff, std::size_t length){
+                AF_RT_SCOPE();
+                if (length == 0){
+                    return;
+                }
+
+                Denormal_Guard guard;
+
+                for (std::size_t i = 0; i < length; i++){
+                    set_g(prewarp(freq_cutoff[i]));
+                    output[i] = tick(input[i]);
+                }
+
+                m_freq_cutoff = static_cast<double>(freq_cutoff[length - 1]);
+            }
+
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             * @return Returns number of bytes needed to save filter state.
+             */
+            std::size_t state_size() const override{
+                return sizeof(std::uint32_t) + 5 * sizeof(T);
+            }
+
+            /**
+             * @brief Method for reseting filter's internal memory (integrator states).
+             */
+            void reset() override{
+                m_ic1eq = static_cast<T>(0);
+                m_ic2eq = static_cast<T>(0);
+            }
+
+            /**
+             * @brief Method for cloning it's self - used to make cascades
+             */
+            std::unique_ptr<Base_Filter<T>> clone() const override {
+                return std::make_unique<StateVariable<T>>(*this);
+            }
+
+            /**
+             * @brief Getter of the object response type.
+             * @return Returns response type of the filter.
+             */
+            SVF_Mode get_mode() const{
+                return m_mode;
+            }
+
+            /**
+             * @brief Getter of the object cutoff frequency.
+             * @return Returns Double type cutoff frequency.
+             */
+            double get_freq_cutoff() const{
+                return m_freq_cutoff;
+            }
+
+            /**
+             * @brief Getter of the object quality factor.
+             * @return Returns Double type quality factor.
+             */
+            double get_q() const{
+                return m_q;
+            }
+
+            /**
+             * @brief Group delay of filter at given frequency for current cutoff, quality factor and mode.
+             * @param freq Double type frequency in Hz.
+             * @return Returns group delay in samples.
+             */
+            double group_delay(double freq) const override{
+                double b[3], a[2];
+                biquad(b, a);
+                return iir_response(b, 3, a, 2, 2.0 * M_PI * freq / this->get_sampling_freq()).delay;
+            }
+
+            /**
+             * @brief Latency of filter, group delay averaged over passband (see passband_latency()).
+             * @return Returns latency in samples.
+             */
+            double get_latency() const override{
+                double b[3], a[2];
+                biquad(b, a);
+                return passband_latency([&](double omega) { return iir_response(b, 3, a, 2, omega); });
+            }
+
+            using Base_Filter<T>::frequency_response;
+
+            /**
+             * @brief Frequency response at arbitrary frequencies for current cutoff, quality factor and mode.
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override{
+                double b[3], a[2];
+                biquad(b, a);
+                for (std::size_t i = 0; i < count; i++) {
+                    response[i] = iir_response(b, 3, a, 2, 2.0 * M_PI * freq[i] / this->get_sampling_freq()).value;
+                }
+            }
+    };
+
+}
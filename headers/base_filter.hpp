@@ -7,6 +7,13 @@
 #include <string>
 #include <cmath>
 #include <memory>
+#include <cstddef>
+#include <complex>
+#include "denormal.hpp"
+#include "filter_state.hpp"
+#include "rt_check.hpp"
+#include "pcm_io.hpp"
+#include "response.hpp"
 
 namespace af{
 
@@ -20,6 +27,44 @@ namespace af{
     private:
         double m_sampling_freq;
         std::string m_filter_name;
+        bool m_flush_denormals = false;
+
+    protected:
+        /**
+         * @brief Virtual method writing filter state (memory) to buffer of at least state_size() bytes.
+         * * Default implementation writes empty state of filter without memory.
+         * @param buffer Pointer to state buffer.
+         * @return Returns number of written bytes.
+         */
+        virtual std::size_t write_state(unsigned char* buffer) const
+        {
+            return state_put_count(buffer, 0) - buffer;
+        }
+
+        /**
+         * @brief Virtual method reading filter state (memory) from buffer into existing memory, without allocation.
+         * @param buffer Pointer to state buffer.
+         * @param size Number of bytes available in buffer.
+         * @return Returns number of read bytes, 0 if state does not match filter configuration.
+         */
+        virtual std::size_t read_state(const unsigned char* buffer, std::size_t size)
+        {
+            const unsigned char* position = buffer;
+            if (!state_get_count(position, buffer + size, 0))
+            {
+                return 0;
+            }
+
+            return position - buffer;
+        }
+
+        /**
+         * @brief Name of filter as C string, used by real-time checker (see AF_RT_SCOPE()) without allocation.
+         */
+        const char* filter_name_c_str() const
+        {
+            return m_filter_name.c_str();
+        }
 
     public:
         /**
@@ -28,6 +73,109 @@ namespace af{
          */
         virtual T filter(T input) = 0;
 
+        /**
+         * @brief Virtual method for filtering/processing a block of samples.
+         * * Default implementation calls filter() for each sample. Input and output may point to the same buffer.
+         * * Start of every block is the point where filters apply pending coeffitient updates.
+         * * Block entry points run with flush-to-zero enabled (see Denormal_Guard).
+         * @param input Pointer to block of input samples.
+         * @param output Pointer to block where filtered samples are written.
+         * @param length Number of samples in block.
+         */
+        virtual void filter_block(const T* input, T* output, std::size_t length)
+        {
+            AF_RT_SCOPE();
+            Denormal_Guard guard;
+
+            for (std::size_t i = 0; i < length; i++)
+            {
+                output[i] = filter(input[i]);
+            }
+        }
+
+        /**
+         * @brief Virtual method for filtering in place samples of one channel of interleaved (or any strided) buffer.
+         * * Default implementation calls filter() for each sample. Avoids copying channel out of interleaved frames and back.
+         * @param data Pointer to first sample of the channel.
+         * @param stride Distance between samples of the channel (number of channels for interleaved frames).
+         * @param length Number of samples of the channel.
+         */
+        virtual void filter_block_strided(T* data, std::size_t stride, std::size_t length)
+        {
+            AF_RT_SCOPE();
+            Denormal_Guard guard;
+
+            for (std::size_t i = 0; i < length; i++, data += stride)
+            {
+                *data = filter(*data);
+            }
+        }
+
+        /**
+         * @brief Virtual method returning sampling frequency of samples written by process().
+         * * Default implementation returns get_sampling_freq() (filter does not change rate).
+         * @return Returns output sampling frequency in Hz.
+         */
+        virtual double get_output_freq() const
+        {
+            return m_sampling_freq;
+        }
+
+        /**
+         * @brief Virtual method returning number of samples written by process() for given input length in the worst case.
+         * * Default implementation returns length (filter does not change rate).
+         * @param length Number of input samples.
+         * @return Returns size of output buffer needed by process().
+         */
+        virtual std::size_t max_output(std::size_t length) const
+        {
+            return length;
+        }
+
+        /**
+         * @brief Virtual method for filtering block with change of sampling frequency (decimators, interpolators, multirate cascades).
+         * * Number of output samples depends on input length and on phase kept from previous blocks. filter() and filter_block()
+         * * of rate changing filters filter at one rate without dropping or inserting samples.
+         * * Default implementation calls filter_block() and returns length.
+         * @param input Pointer to block of input samples.
+         * @param length Number of input samples.
+         * @param output Pointer to at least max_output(length) samples (can be the same as input if rate is not raised).
+         * @return Returns number of written output samples.
+         */
+        virtual std::size_t process(const T* input, std::size_t length, T* output)
+        {
+            filter_block(input, output, length);
+            return length;
+        }
+
+        /**
+         * @brief Filters block of PCM samples of one channel (int16, int24 or float32), with conversion fused into filtering.
+         * * Samples are converted in chunks of 256 kept on stack and filtered with filter_block(), so PCM memory is read and written
+         * * only once instead of separate conversion, filtering and back conversion passes over whole block.
+         * * Pending coeffitient updates can be applied at chunk boundaries.
+         * @param input Pointer to first input sample of the channel.
+         * @param output Pointer to first output sample of the channel (can be the same as input).
+         * @param length Number of samples of the channel.
+         * @param format Format of PCM samples.
+         * @param channels Number of interleaved channels (samples of the channel are channels samples apart).
+         * @param dither Optional TPDF dither added before rounding to integer formats (nullptr for plain rounding).
+         */
+        void filter_block_pcm(const unsigned char* input, unsigned char* output, std::size_t length, PCM_Format format, int channels = 1, TPDF_Dither* dither = nullptr)
+        {
+            const std::size_t chunk_length = 256;
+            const std::size_t stride = pcm_sample_size(format) * static_cast<std::size_t>(channels);
+            T chunk[chunk_length];
+            Denormal_Guard guard;
+
+            for (std::size_t done = 0; done < length; done += chunk_length)
+            {
+                std::size_t count = length - done < chunk_length ? length - done : chunk_length;
+                pcm_decode(input + done * stride, format, channels, 0, chunk, count);
+                filter_block(chunk, chunk, count);
+                pcm_encode(chunk, output + done * stride, format, channels, 0, count, dither);
+            }
+        }
+
         /**
          * @brief Virtual method for cloning filters - used to make safe cascades of filters.
          */
@@ -38,6 +186,75 @@ namespace af{
          */
         virtual void reset() = 0;
 
+        /**
+         * @brief Virtual method returning group delay of filter at given frequency.
+         * * Default implementation returns 0 (response of filter is not known). Rate changing filters count samples
+         * * of the higher of input and output rate.
+         * @param freq Double type frequency in Hz.
+         * @return Returns group delay in samples.
+         */
+        virtual double group_delay(double freq) const
+        {
+            (void)freq;
+            return 0.0;
+        }
+
+        /**
+         * @brief Virtual method returning latency of filter in samples, used to align parallel paths and to budget delay of chains.
+         * * Linear phase FIR filters return exact delay order / 2, other filters group delay averaged over passband.
+         * * Filters processing in internal blocks (for example FFT convolution) have to add their buffering latency.
+         * * Default implementation returns group_delay(0).
+         * @return Returns latency in samples.
+         */
+        virtual double get_latency() const
+        {
+            return group_delay(0.0);
+        }
+
+        /**
+         * @brief Virtual method evaluating complex frequency response at arbitrary frequencies.
+         * * Default implementation measures first 8192 samples of impulse response of a clone (filter state is untouched),
+         * * filters with known coeffitients override it with exact evaluation.
+         * @param freq Pointer to frequencies in Hz.
+         * @param response Pointer to count values of H written.
+         * @param count Number of frequencies.
+         */
+        virtual void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const
+        {
+            const std::size_t IMPULSE_LENGTH = 8192;
+            std::unique_ptr<Base_Filter<T>> copy = clone();
+            copy->reset();
+
+            std::vector<T> impulse(IMPULSE_LENGTH, static_cast<T>(0));
+            impulse[0] = static_cast<T>(1);
+            copy->filter_block(impulse.data(), impulse.data(), IMPULSE_LENGTH);
+
+            std::vector<double> omega(count);
+            for (std::size_t i = 0; i < count; i++) {
+                omega[i] = 2.0 * M_PI * freq[i] / m_sampling_freq;
+            }
+            poly_response_batch(impulse.data(), IMPULSE_LENGTH, omega.data(), response, count);
+        }
+
+        /**
+         * @brief Virtual method evaluating complex frequency response at n_points evenly spaced frequencies k * fs / (2 n_points),
+         * * k = 0 .. n_points - 1 (0 up to Nyquist frequency, not included). Default implementation calls frequency_response()
+         * * for arbitrary frequencies, FIR and IIR filters use FFT of coeffitients.
+         * @param n_points Number of frequencies.
+         * @return Returns vector of H values.
+         */
+        virtual std::vector<std::complex<double>> frequency_response(std::size_t n_points) const
+        {
+            std::vector<double> freq(n_points);
+            for (std::size_t k = 0; k < n_points; k++) {
+                freq[k] = 0.5 * m_sampling_freq * static_cast<double>(k) / static_cast<double>(n_points);
+            }
+
+            std::vector<std::complex<double>> response(n_points);
+            frequency_response(freq.data(), response.data(), n_points);
+            return response;
+        }
+
         /**
          * @brief Parametric constructor of base class.
          * @param sampling_freq Sampling Frequency of the provided data. Cannot be 0 or less.
@@ -99,6 +316,84 @@ namespace af{
             }
         }
 
+        /**
+         * @brief Virtual method returning size of binary filter state (see save_state()).
+         * @return Returns number of bytes needed to save state.
+         */
+        virtual std::size_t state_size() const
+        {
+            return sizeof(std::uint32_t);
+        }
+
+        /**
+         * @brief Saves filter state (memory of filter, recursively for cascades) to compact binary form.
+         * * Coeffitients and parameters are not saved - state can be loaded to filter of the same configuration.
+         * * Pending coeffitient updates and running crossfade are not part of the state.
+         * @param buffer Pointer to state buffer.
+         * @param capacity Size of buffer in bytes.
+         * @return Returns number of written bytes, 0 if buffer is smaller than state_size().
+         */
+        std::size_t save_state(unsigned char* buffer, std::size_t capacity) const
+        {
+            if (capacity < state_size())
+            {
+                return 0;
+            }
+
+            return write_state(buffer);
+        }
+
+        /**
+         * @brief Saves filter state to newly allocated vector (see save_state(unsigned char*, std::size_t)).
+         * @return Returns vector with binary state.
+         */
+        std::vector<unsigned char> save_state() const
+        {
+            std::vector<unsigned char> state(state_size());
+            write_state(state.data());
+            return state;
+        }
+
+        /**
+         * @brief Loads filter state saved by save_state(). Does not allocate, so it can be used every block.
+         * @param buffer Pointer to state buffer.
+         * @param size Size of buffer in bytes.
+         * @return Returns number of read bytes, 0 if state does not match filter configuration (filter memory may be partially changed then).
+         */
+        std::size_t load_state(const unsigned char* buffer, std::size_t size)
+        {
+            return read_state(buffer, size);
+        }
+
+        /**
+         * @brief Loads filter state saved by save_state().
+         * @param state Vector with binary state.
+         * @return Returns true if whole state was loaded, otherwise false.
+         */
+        bool load_state(const std::vector<unsigned char>& state)
+        {
+            return !state.empty() && read_state(state.data(), state.size()) == state.size();
+        }
+
+        /**
+         * @brief Setter of per-filter flushing of tiny state values to zero (see flush_tiny()).
+         * * Protects filters from subnormal numbers also when called per sample, without Denormal_Guard. Off by default.
+         * @param flush True to enable flushing, false to disable.
+         */
+        virtual void set_flush_denormals(bool flush)
+        {
+            m_flush_denormals = flush;
+        }
+
+        /**
+         * @brief Getter of per-filter flushing of tiny state values.
+         * @return Returns true if flushing is enabled.
+         */
+        bool get_flush_denormals() const
+        {
+            return m_flush_denormals;
+        }
+
         /**
          * @brief Getter of sampling frequency of base structure. Returns double.
          * @return Returns double value of filter's sampling frequency.
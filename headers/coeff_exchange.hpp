@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "shared_coeff.hpp"
+
+namespace af{
+
+    /**
+     * @brief Layout of zero taps of FIR, selects kernel which multiplies only nonzero taps (see FIR::get_tap_layout()).
+     */
+    enum class Tap_Layout {
+        Dense,          // all taps are used
+        Alternating,    // every other tap is zero (Hilbert transformer, bandpass at fs / 4)
+        Halfband,       // every other tap is zero except center tap
+        Sparse          // arbitrary positions of few nonzero taps
+    };
+
+    /**
+     * @brief Nonzero taps of FIR packed for zero skipping kernel. Strided layouts keep every other tap starting at first,
+     * * Sparse layout keeps positions of taps in index. Built by control thread together with coeffitients.
+     * @tparam T is type of numerical data.
+     */
+    template <typename T>
+    struct Sparse_Taps {
+        Tap_Layout layout = Tap_Layout::Dense;
+        std::vector<T> value;
+        std::vector<std::uint32_t> index;
+        std::size_t first = 0;
+        std::size_t center = 0;
+        T center_value = static_cast<T>(0);
+    };
+
+    /**
+     * @brief Coeff_Slot holds one prepared set of coeffitients handed from control thread to filtering thread.
+     * * History vectors are sized by the control thread, so the filtering thread never allocates when order changes.
+     * @tparam T is type of numerical data.
+     */
+    template <typename T>
+    struct Coeff_Slot {
+        Shared_Coeff<T> coeff_b;
+        Shared_Coeff<T> coeff_a;
+        std::vector<T> past_input;
+        std::vector<T> past_output;
+        std::size_t crossfade = 0;
+        Sparse_Taps<T> taps;
+    };
+
+    /**
+     * @brief Coeff_Exchange is a lock-free single producer / single consumer triple buffer of coeffitient slots.
+     * * Control thread fills back slot and publishes it, filtering thread fetches it at block boundary.
+     * * Retired slots return to the control thread, so memory is released and reused only there.
+     * @tparam T is type of numerical data.
+     */
+    template <typename T>
+    class Coeff_Exchange {
+        private:
+            static constexpr int DIRTY = 4;
+            static constexpr int INDEX = 3;
+
+            Coeff_Slot<T> m_slots[3];
+            std::atomic<int> m_middle;
+            int m_front;
+            int m_back;
+
+        public:
+
+            /**
+             * @brief Default constructor of exchange. Slot 0 is held by consumer, slot 2 by producer.
+             */
+            Coeff_Exchange() : m_middle(1), m_front(0), m_back(2) {}
+
+            /**
+             * @brief Copy constructor - pending updates are not copied, consumer slot is copied
+             * * (it holds outgoing coeffitients while crossfade is running).
+             */
+            Coeff_Exchange(const Coeff_Exchange& other) : Coeff_Exchange() {
+                m_slots[m_front] = other.m_slots[other.m_front];
+            }
+
+            /**
+             * @brief Copy assignment - pending updates are not copied, consumer slot is copied (see copy constructor).
+             */
+            Coeff_Exchange& operator=(const Coeff_Exchange& other) {
+                if (this != &other) {
+                    m_slots[m_front] = other.m_slots[other.m_front];
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Getter of producer slot. Only control thread may use it.
+             * @return Returns reference to slot that will be published next.
+             */
+            Coeff_Slot<T>& back() {
+                return m_slots[m_back];
+            }
+
+            /**
+             * @brief Publishes back slot to the consumer (control thread).
+             */
+            void publish() {
+                int prev = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel);
+                m_back = prev & INDEX;
+            }
+
+            /**
+             * @brief Checks if published slot is waiting for consumer.
+             * @return Returns true if update is pending.
+             */
+            bool pending() const {
+                return (m_middle.load(std::memory_order_acquire) & DIRTY) != 0;
+            }
+
+            /**
+             * @brief Takes newest published slot (filtering thread). Never allocates.
+             * @return Returns true if new slot was taken, otherwise false.
+             */
+            bool fetch() {
+                if (!pending()) {
+                    return false;
+                }
+
+                int prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+                m_front = prev & INDEX;
+                return true;
+            }
+
+            /**
+             * @brief Getter of consumer slot. Only filtering thread may use it.
+             * @return Returns reference to last fetched slot.
+             */
+            Coeff_Slot<T>& front() {
+                return m_slots[m_front];
+            }
+    };
+
+}
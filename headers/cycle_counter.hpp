@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define AF_CYCLES_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define AF_CYCLES_TSC
+#endif
+
+namespace af{
+
+    /**
+     * @brief Reads cheap monotonic cycle counter of the CPU.
+     * * x86 - time stamp counter (rdtsc), ARM64 - virtual counter, other platforms - steady clock in nanoseconds.
+     * @return Returns current counter value.
+     */
+    inline std::uint64_t read_cycles() {
+#if defined(AF_CYCLES_TSC)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t value;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Frequency of read_cycles() counter, calibrated once against steady clock (about 20 ms on first call).
+     * @return Returns number of counter ticks per nanosecond.
+     */
+    inline double cycles_per_ns() {
+        static const double ratio = [] {
+            auto start = std::chrono::steady_clock::now();
+            std::uint64_t c_start = read_cycles();
+            while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(20)) {
+            }
+            std::uint64_t c_stop = read_cycles();
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            return static_cast<double>(c_stop - c_start) / ns;
+        }();
+
+        return ratio;
+    }
+
+}
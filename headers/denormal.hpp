@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define AF_DENORMAL_SSE
+#elif defined(__aarch64__)
+#define AF_DENORMAL_ARM64
+#endif
+
+namespace af{
+
+    /**
+     * @brief Denormal_Guard is scoped flush-to-zero / denormals-are-zero switch of the calling thread.
+     * * Constructor enables FTZ and DAZ (x86 SSE) or FZ (ARM64), destructor restores previous mode.
+     * * Used by block-processing entry points. Define AF_DISABLE_DENORMAL_GUARD to compile it out.
+     */
+    class Denormal_Guard {
+        private:
+#if defined(AF_DENORMAL_SSE) && !defined(AF_DISABLE_DENORMAL_GUARD)
+            unsigned int m_saved;
+#elif defined(AF_DENORMAL_ARM64) && !defined(AF_DISABLE_DENORMAL_GUARD)
+            unsigned long m_saved;
+#endif
+
+        public:
+
+            /**
+             * @brief Constructor enabling flush-to-zero mode. Register is written only if mode is not set yet.
+             */
+            Denormal_Guard() {
+#if defined(AF_DENORMAL_SSE) && !defined(AF_DISABLE_DENORMAL_GUARD)
+                m_saved = _mm_getcsr();
+                unsigned int mode = m_saved | 0x8040u; // FTZ (bit 15) and DAZ (bit 6)
+                if (mode != m_saved) {
+                    _mm_setcsr(mode);
+                }
+#elif defined(AF_DENORMAL_ARM64) && !defined(AF_DISABLE_DENORMAL_GUARD)
+                __asm__ __volatile__("mrs %0, fpcr" : "=r"(m_saved));
+                unsigned long mode = m_saved | (1ul << 24); // FZ
+                if (mode != m_saved) {
+                    __asm__ __volatile__("msr fpcr, %0" : : "r"(mode));
+                }
+#endif
+            }
+
+            /**
+             * @brief Destructor restoring previous floating point mode.
+             */
+            ~Denormal_Guard() {
+#if defined(AF_DENORMAL_SSE) && !defined(AF_DISABLE_DENORMAL_GUARD)
+                if (_mm_getcsr() != m_saved) {
+                    _mm_setcsr(m_saved);
+                }
+#elif defined(AF_DENORMAL_ARM64) && !defined(AF_DISABLE_DENORMAL_GUARD)
+                __asm__ __volatile__("msr fpcr, %0" : : "r"(m_saved));
+#endif
+            }
+
+            Denormal_Guard(const Denormal_Guard&) = delete;
+            Denormal_Guard& operator=(const Denormal_Guard&) = delete;
+    };
+
+    /**
+     * @brief Flushes values too small to be audible to exact zero, so feedback state never becomes subnormal.
+     * * Threshold is 1e-20 (-400 dB), far below resolution of any sample format. Integer types are not changed.
+     * @tparam T is type of numerical data.
+     * @param value Value of filter state.
+     * @return Returns value or zero.
+     */
+    template <typename T>
+    inline T flush_tiny(T value) {
+        if constexpr (std::is_floating_point<T>::value) {
+            return (std::fabs(value) < static_cast<T>(1e-20)) ? static_cast<T>(0) : value;
+        }
+        else {
+            return value;
+        }
+    }
+
+}
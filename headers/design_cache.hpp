@@ -0,0 +1,194 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+#include <unordered_map>
+#include "shared_coeff.hpp"
+
+namespace af{
+
+    /**
+     * @brief Types of designed filters kept in Design_Cache.
+     */
+    enum class Design_Type { Lowpass, Highpass, Bandpass, Bandstop, ChebyshevLowpass, ChebyshevHighpass,
+                             Chebyshev2Lowpass, Chebyshev2Highpass, ButterworthLowpass, ButterworthHighpass };
+
+    /**
+     * @brief Key of designed coeffitients. Unused frequencies and ripple are 0.
+     */
+    struct Design_Key {
+        Design_Type type;
+        double sampling_freq;
+        int order;
+        double freq_1;
+        double freq_2;
+        double ripple;
+
+        bool operator==(const Design_Key& other) const {
+            return type == other.type && sampling_freq == other.sampling_freq && order == other.order
+                && freq_1 == other.freq_1 && freq_2 == other.freq_2 && ripple == other.ripple;
+        }
+    };
+
+    /**
+     * @brief Hash of Design_Key combining bit patterns of all fields.
+     */
+    struct Design_Key_Hash {
+        std::size_t operator()(const Design_Key& key) const {
+            std::uint64_t h = static_cast<std::uint64_t>(key.type) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(key.order);
+            for (double value : {key.sampling_freq, key.freq_1, key.freq_2, key.ripple}) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                h = (h ^ bits) * 0x100000001B3ull;
+                h ^= h >> 29;
+            }
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    /**
+     * @brief Designed coeffitients kept in cache. FIR designs use only coeff_b, SOS designs keep sections in coeff_b.
+     */
+    template <typename T>
+    struct Design_Entry {
+        Shared_Coeff<T> coeff_b;
+        Shared_Coeff<T> coeff_a;
+    };
+
+    /**
+     * @brief Statistics of Design_Cache, used to choose it's capacity.
+     */
+    struct Design_Cache_Stats {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t evictions;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+    /**
+     * @brief Design_Cache is thread safe, bounded (least recently used) cache of designed coeffitients.
+     * * Designed filter classes consult it in constructors and upadte_coeffs(), so identical filters share one copy of coeffitients.
+     * * One cache exists for each numerical type (see instance()). Capacity 0 disables caching.
+     * @tparam T is type of numerical data of coeffitients.
+     */
+    template <typename T>
+    class Design_Cache {
+        private:
+            using Item = std::pair<Design_Key, Design_Entry<T>>;
+
+            mutable std::mutex m_mutex;
+            std::list<Item> m_items;
+            std::unordered_map<Design_Key, typename std::list<Item>::iterator, Design_Key_Hash> m_index;
+            std::size_t m_capacity;
+            std::size_t m_hits = 0;
+            std::size_t m_misses = 0;
+            std::size_t m_evictions = 0;
+
+            /**
+             * @brief Removes least recently used items above capacity. Mutex must be locked.
+             */
+            void trim() {
+                while (m_items.size() > m_capacity) {
+                    m_index.erase(m_items.back().first);
+                    m_items.pop_back();
+                    m_evictions++;
+                }
+            }
+
+        public:
+
+            /**
+             * @brief Constructor of cache.
+             * @param capacity Maximal number of kept designs.
+             */
+            explicit Design_Cache(std::size_t capacity = 1024) : m_capacity(capacity) {}
+
+            Design_Cache(const Design_Cache&) = delete;
+            Design_Cache& operator=(const Design_Cache&) = delete;
+
+            /**
+             * @brief Getter of global cache used by designed filter classes.
+             * @return Returns reference to cache for numerical type T.
+             */
+            static Design_Cache& instance() {
+                static Design_Cache cache;
+                return cache;
+            }
+
+            /**
+             * @brief Returns cached design or calculates it with given function and stores it.
+             * * Design is calculated without holding the lock, so slow designs don't block other threads.
+             * @param key Parameters of design.
+             * @param design Function returning Design_Entry<T> for key, called only on miss.
+             * @return Returns shared coeffitients of design.
+             */
+            template <typename F>
+            Design_Entry<T> get(const Design_Key& key, F&& design) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto found = m_index.find(key);
+
+                    if (found != m_index.end()) {
+                        m_items.splice(m_items.begin(), m_items, found->second);
+                        m_hits++;
+                        return found->second->second;
+                    }
+
+                    m_misses++;
+                }
+
+                Design_Entry<T> entry = design();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_capacity > 0 && m_index.find(key) == m_index.end()) {
+                    m_items.emplace_front(key, entry);
+                    m_index[key] = m_items.begin();
+                    trim();
+                }
+
+                return entry;
+            }
+
+            /**
+             * @brief Setter of capacity. Least recently used designs above new capacity are removed.
+             * @param capacity Maximal number of kept designs (0 disables caching).
+             */
+            void set_capacity(std::size_t capacity) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_capacity = capacity;
+                trim();
+            }
+
+            /**
+             * @brief Removes all designs. Filters using them keep their coeffitients.
+             */
+            void clear() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_items.clear();
+                m_index.clear();
+            }
+
+            /**
+             * @brief Sets hit, miss and eviction counters to 0.
+             */
+            void reset_stats() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_hits = 0;
+                m_misses = 0;
+                m_evictions = 0;
+            }
+
+            /**
+             * @brief Getter of cache statistics.
+             * @return Returns hits, misses, evictions, current size and capacity.
+             */
+            Design_Cache_Stats get_stats() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return {m_hits, m_misses, m_evictions, m_items.size(), m_capacity};
+            }
+    };
+
+}
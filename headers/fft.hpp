@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+namespace af{
+
+    /**
+     * @brief Smallest power of two not smaller than given size.
+     */
+    inline std::size_t fft_size(std::size_t size) {
+        std::size_t result = 1;
+        while (result < size) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    /**
+     * @brief In-place iterative radix-2 FFT used by design and analysis helpers (not for real-time use, table of twiddles
+     * * is allocated and calculated on every call).
+     * @param data Complex samples, size has to be power of two.
+     * @param inverse True for inverse transform (result is scaled by 1 / size).
+     * @return Returns false if size is not power of two.
+     */
+    inline bool fft(std::vector<std::complex<double>>& data, bool inverse = false) {
+        const std::size_t size = data.size();
+        if (size == 0 || (size & (size - 1)) != 0) {
+            return false;
+        }
+
+        for (std::size_t i = 1, j = 0; i < size; i++) {
+            std::size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(data[i], data[j]);
+            }
+        }
+
+        // twiddles for the whole transform, stage of given length uses every (size / length)-th of them
+        const double sign = inverse ? 1.0 : -1.0;
+        std::vector<std::complex<double>> twiddle(size / 2);
+        for (std::size_t k = 0; k < size / 2; k++) {
+            const double angle = sign * 2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size);
+            twiddle[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+
+        for (std::size_t length = 2; length <= size; length <<= 1) {
+            const std::size_t half = length / 2;
+            const std::size_t stride = size / length;
+
+            for (std::size_t k = 0; k < half; k++) {
+                // written out, std::complex multiplication checks for infinities and NaNs
+                const double w_re = twiddle[k * stride].real();
+                const double w_im = twiddle[k * stride].imag();
+                for (std::size_t start = k; start < size; start += length) {
+                    const std::complex<double> b = data[start + half];
+                    const std::complex<double> odd(b.real() * w_re - b.imag() * w_im, b.real() * w_im + b.imag() * w_re);
+                    data[start + half] = data[start] - odd;
+                    data[start] += odd;
+                }
+            }
+        }
+
+        if (inverse) {
+            const double scale = 1.0 / static_cast<double>(size);
+            for (std::complex<double>& value : data) {
+                value *= scale;
+            }
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include "filter_type.hpp"
+#include "filter_cascade.hpp"
+#include "multirate.hpp"
+#include "mapped_file.hpp"
+
+namespace af{
+
+    /**
+     * @brief Layout of binary filter bank file (version 1, native byte order).
+     * * File starts with Bank_Header, followed by records of top-level filters. Cascade record is followed by records of it's stages.
+     * * Every record is Bank_Record, name, coeffitients b, coeffitients a - each part starts at multiple of BANK_ALIGN bytes.
+     * * SOS record keeps sections in coeffitients b and has no coeffitients a.
+     * * Decimator record keeps FIR coeffitients in coeffitients b and decimation factor in factor (0 for other records).
+     */
+    const std::uint64_t BANK_MAGIC = 0x314B4E4142465041ull; // "APFBANK1"
+    const std::uint32_t BANK_VERSION = 1;
+    const std::uint32_t BANK_BYTE_ORDER = 0x01020304u;
+    const std::size_t BANK_ALIGN = 64;
+
+    enum class Bank_Kind : std::uint32_t { FIR = 0, IIR = 1, Cascade = 2, SOS = 3, Decimator = 4 };
+
+    struct Bank_Header {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t value_size;
+        std::uint32_t reserved;
+        std::uint64_t filter_count;
+        std::uint64_t file_size;
+    };
+
+    struct Bank_Record {
+        std::uint32_t kind;
+        std::uint32_t stage_count;
+        double sampling_freq;
+        std::uint64_t name_length;
+        std::uint64_t size_b;
+        std::uint64_t size_a;
+        std::uint64_t factor;
+    };
+
+    /**
+     * @brief Helper rounding size up to multiple of BANK_ALIGN.
+     */
+    inline std::uint64_t bank_align(std::uint64_t size) {
+        return (size + BANK_ALIGN - 1) / BANK_ALIGN * BANK_ALIGN;
+    }
+
+    /**
+     * @brief Helper writing one filter (and stages of cascade) to stream.
+     * @return Returns false if filter is not FIR, IIR, SOS, Decimator or Cascade of them (other rate changing filters,
+     * * for example CIC, are not supported).
+     */
+    template <typename T>
+    bool write_bank_record(std::ostream& out, const Base_Filter<T>& filter) {
+        Bank_Record record{};
+        const T* data_b = nullptr;
+        const T* data_a = nullptr;
+        const Cascade<T>* cascade = dynamic_cast<const Cascade<T>*>(&filter);
+
+        if (const Decimator<T>* decimator = dynamic_cast<const Decimator<T>*>(&filter)) {
+            record.kind = static_cast<std::uint32_t>(Bank_Kind::Decimator);
+            record.factor = decimator->get_factor();
+            record.size_b = decimator->get_coeff().size();
+            data_b = decimator->get_coeff().data();
+        }
+        else if (!cascade && filter.get_output_freq() != filter.get_sampling_freq()) {
+            return false;
+        }
+        else if (const FIR<T>* fir = dynamic_cast<const FIR<T>*>(&filter)) {
+            record.kind = static_cast<std::uint32_t>(Bank_Kind::FIR);
+            record.size_b = fir->get_coeff().size();
+            data_b = fir->get_coeff().data();
+        }
+        else if (const IIR<T>* iir = dynamic_cast<const IIR<T>*>(&filter)) {
+            record.kind = static_cast<std::uint32_t>(Bank_Kind::IIR);
+            record.size_b = iir->get_coeff_b().size();
+            record.size_a = iir->get_coeff_a().size();
+            data_b = iir->get_coeff_b().data();
+            data_a = iir->get_coeff_a().data();
+        }
+        else if (const SOS<T>* sos = dynamic_cast<const SOS<T>*>(&filter)) {
+            record.kind = static_cast<std::uint32_t>(Bank_Kind::SOS);
+            record.size_b = sos->get_sections().size();
+            data_b = sos->get_sections().data();
+        }
+        else if (cascade) {
+            record.kind = static_cast<std::uint32_t>(Bank_Kind::Cascade);
+            record.stage_count = static_cast<std::uint32_t>(cascade->size());
+        }
+        else {
+            return false;
+        }
+
+        std::string name = filter.get_filter_name();
+        record.sampling_freq = filter.get_sampling_freq();
+        record.name_length = name.size();
+
+        const char zeros[BANK_ALIGN] = {};
+        auto write_part = [&](const void* data, std::uint64_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            out.write(zeros, static_cast<std::streamsize>(bank_align(bytes) - bytes));
+        };
+
+        write_part(&record, sizeof(record));
+        write_part(name.data(), name.size());
+        write_part(data_b, record.size_b * sizeof(T));
+        write_part(data_a, record.size_a * sizeof(T));
+
+        if (cascade) {
+            for (std::size_t i = 0; i < cascade->size(); i++) {
+                if (!write_bank_record(out, cascade->get_filter(i))) {
+                    return false;
+                }
+            }
+        }
+
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Writes filters to versioned, aligned binary filter bank file (see load_filter_bank()).
+     * * Designed filters (Lowpass, ChebyshevLowpass, ...) are stored as their FIR/SOS coeffitients.
+     * @param path Path of file to write.
+     * @param filters Pointers to FIR, IIR, SOS, Decimator or Cascade objects (cascades may be nested).
+     * @return Returns true if succesful, false if file cannot be written or filter type is not supported.
+     */
+    template <typename T>
+    bool write_filter_bank(const std::string& path, const std::vector<const Base_Filter<T>*>& filters) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+
+        Bank_Header header{BANK_MAGIC, BANK_VERSION, BANK_BYTE_ORDER, static_cast<std::uint32_t>(sizeof(T)), 0, filters.size(), 0};
+        const char zeros[BANK_ALIGN] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(zeros, static_cast<std::streamsize>(bank_align(sizeof(header)) - sizeof(header)));
+
+        for (const Base_Filter<T>* filter : filters) {
+            if (!filter || !write_bank_record(out, *filter)) {
+                return false;
+            }
+        }
+
+        header.file_size = static_cast<std::uint64_t>(out.tellp());
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Helper building one filter (and stages of cascade) from mapped record.
+     * * Record without coeffitients (filter of invalid design) builds filter passing samples unchanged.
+     * @param file Shared mapped file, kept alive by coeffitients of built filters.
+     * @param offset Offset of record, moved past the record (and stages).
+     * @param depth Nesting depth of cascades, limited to protect from corrupted files.
+     * @return Returns built filter or nullptr if record is invalid.
+     */
+    template <typename T>
+    std::unique_ptr<Base_Filter<T>> read_bank_record(const std::shared_ptr<const Mapped_File>& file, std::uint64_t& offset, int depth) {
+        const std::uint64_t size = file->size();
+        if (depth > 64 || offset > size || size - offset < sizeof(Bank_Record)) {
+            return nullptr;
+        }
+
+        Bank_Record record;
+        std::memcpy(&record, file->data() + offset, sizeof(record));
+        offset += bank_align(sizeof(record));
+
+        const std::uint64_t limit = size / sizeof(T);
+        if (record.name_length > size || record.size_b > limit || record.size_a > limit) {
+            return nullptr;
+        }
+
+        std::uint64_t name_offset = offset;
+        std::uint64_t b_offset = name_offset + bank_align(record.name_length);
+        std::uint64_t a_offset = b_offset + bank_align(record.size_b * sizeof(T));
+        offset = a_offset + bank_align(record.size_a * sizeof(T));
+        if (offset > size) {
+            return nullptr;
+        }
+
+        std::string name(reinterpret_cast<const char*>(file->data() + name_offset), record.name_length);
+        const T* data_b = reinterpret_cast<const T*>(file->data() + b_offset);
+        const T* data_a = reinterpret_cast<const T*>(file->data() + a_offset);
+
+        switch (static_cast<Bank_Kind>(record.kind)) {
+            case Bank_Kind::FIR: {
+                auto fir = std::make_unique<FIR<T>>(record.sampling_freq, name);
+                if (record.size_b > 0 && !fir->set_coeff(Shared_Coeff<T>::view(file, data_b, record.size_b))) {
+                    return nullptr;
+                }
+                return fir;
+            }
+            case Bank_Kind::IIR: {
+                auto iir = std::make_unique<IIR<T>>(record.sampling_freq, name);
+                if ((record.size_b > 0 || record.size_a > 0)
+                    && !iir->set_coeff(Shared_Coeff<T>::view(file, data_b, record.size_b), Shared_Coeff<T>::view(file, data_a, record.size_a))) {
+                    return nullptr;
+                }
+                return iir;
+            }
+            case Bank_Kind::SOS: {
+                auto sos = std::make_unique<SOS<T>>(record.sampling_freq, name);
+                if (record.size_b > 0 && !sos->set_coeff(Shared_Coeff<T>::view(file, data_b, record.size_b))) {
+                    return nullptr;
+                }
+                return sos;
+            }
+            case Bank_Kind::Decimator: {
+                if (record.factor == 0) {
+                    return nullptr;
+                }
+                auto decimator = std::make_unique<Decimator<T>>(record.sampling_freq, name, static_cast<std::size_t>(record.factor), std::vector<T>());
+                if (record.size_b > 0 && !decimator->set_coeff(Shared_Coeff<T>::view(file, data_b, record.size_b))) {
+                    return nullptr;
+                }
+                return decimator;
+            }
+            case Bank_Kind::Cascade: {
+                auto cascade = std::make_unique<Cascade<T>>(record.sampling_freq, name);
+                for (std::uint32_t i = 0; i < record.stage_count; i++) {
+                    if (!cascade->add_filter(read_bank_record<T>(file, offset, depth + 1))) {
+                        return nullptr;
+                    }
+                }
+                return cascade;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * @brief Loads filter bank written by write_filter_bank(). File is memory mapped and FIR/IIR/SOS coeffitients
+     * * reference mapped memory without copy (mapping lives as long as any loaded filter or it's clone).
+     * @param path Path of file.
+     * @return Returns vector of loaded filters. Empty if file is missing, corrupted, of other version or numerical type.
+     */
+    template <typename T>
+    std::vector<std::unique_ptr<Base_Filter<T>>> load_filter_bank(const std::string& path) {
+        std::vector<std::unique_ptr<Base_Filter<T>>> filters;
+        auto file = std::make_shared<const Mapped_File>(path);
+
+        Bank_Header header;
+        if (!file->is_open() || file->size() < sizeof(header)) {
+            return filters;
+        }
+
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (header.magic != BANK_MAGIC || header.version != BANK_VERSION || header.byte_order != BANK_BYTE_ORDER
+            || header.value_size != sizeof(T) || header.file_size != file->size()) {
+            return filters;
+        }
+
+        std::uint64_t offset = bank_align(sizeof(header));
+        filters.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(header.filter_count, file->size() / BANK_ALIGN)));
+
+        for (std::uint64_t i = 0; i < header.filter_count; i++) {
+            auto filter = read_bank_record<T>(file, offset, 0);
+            if (!filter) {
+                filters.clear();
+                return filters;
+            }
+            filters.push_back(std::move(filter));
+        }
+
+        return filters;
+    }
+
+}
@@ -1,18 +1,97 @@
 #pragma once
 
 #include "base_filter.hpp"
+#include "stage_profile.hpp"
+#include <algorithm>
 
 namespace af{
 
     /**
      * @brief Cascade class holding a vector of unique pointers to any filters or cascades.
      * * This class is used to make filtering cascades of filters. Implements filteing, reseting and adding new filters to cascade methods.
+     * * Stages may change sampling frequency (Decimator, CIC), next stage then runs at output frequency of previous one
+     * * and blocks with rate change go through process().
+     * * Per-stage profiling counters are compiled in only with AF_CASCADE_PROFILING defined (see set_profiling()).
      * @tparam Is a numerical type of input samples that will be filtered.
      */
     template <typename T>
     class Cascade : public Base_Filter<T> {
         private:
             std::vector<std::unique_ptr<Base_Filter<T>>> m_cascade;
+            std::size_t m_tile_length = 0;
+            std::vector<T> m_scratch;
+            std::size_t m_scratch_tile = 0;
+            std::size_t m_scratch_size = 0;
+#ifdef AF_CASCADE_PROFILING
+            std::vector<Stage_Profile> m_profile;
+            bool m_profiling = false;
+#endif
+
+            /**
+             * @brief Helper sizing two intermediate buffers of process() for current tile length, so process() never allocates.
+             * * Each buffer holds the longest output of stages before the last one for one input tile.
+             */
+            void prepare_scratch() {
+                m_scratch_tile = get_tile_length();
+                m_scratch_size = 0;
+                std::size_t length = m_scratch_tile;
+                for (std::size_t i = 0; i + 1 < m_cascade.size(); i++) {
+                    length = m_cascade[i]->max_output(length);
+                    m_scratch_size = std::max(m_scratch_size, length);
+                }
+                m_scratch.assign(2 * m_scratch_size, static_cast<T>(0));
+            }
+
+            /**
+             * @brief Helper converting delay of stage to samples at input rate of cascade (see Base_Filter::group_delay()).
+             * @param stage Stage of cascade.
+             * @return Returns factor multiplying delay of stage.
+             */
+            double delay_scale(const Base_Filter<T>& stage) const {
+                return this->get_sampling_freq() / std::max(stage.get_sampling_freq(), stage.get_output_freq());
+            }
+
+        protected:
+
+            /**
+             * @brief Writes number of stages and state of each stage (recursively) as binary state.
+             * @param buffer Pointer to state buffer of at least state_size() bytes.
+             * @return Returns number of written bytes.
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                unsigned char* position = state_put_count(buffer, static_cast<std::uint32_t>(m_cascade.size()));
+
+                for(const auto& f : m_cascade){
+                    position += f->save_state(position, f->state_size());
+                }
+
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads state of each stage (recursively) from binary state, without allocation.
+             * @param buffer Pointer to state buffer.
+             * @param size Number of bytes available in buffer.
+             * @return Returns number of read bytes, 0 if state does not match structure of cascade.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                const unsigned char* end = buffer + size;
+
+                if (!state_get_count(position, end, static_cast<std::uint32_t>(m_cascade.size()))) {
+                    return 0;
+                }
+
+                for(auto& f : m_cascade){
+                    std::size_t read = f->load_state(position, end - position);
+                    if (read == 0) {
+                        return 0;
+                    }
+                    position += read;
+                }
+
+                return position - buffer;
+            }
 
         public:
 
@@ -33,20 +112,40 @@ namespace af{
              * @brief Cloning constructor - enables cloning of it's self.
              * @param other is an pointer to Cascade object.
              */
-            Cascade(const Cascade& other) : Base_Filter<T>(other.get_sampling_freq(), other.get_filter_name()) {
+            Cascade(const Cascade& other) : Base_Filter<T>(other.get_sampling_freq(), other.get_filter_name()), m_tile_length(other.m_tile_length) {
+                Base_Filter<T>::set_flush_denormals(other.get_flush_denormals());
                 for (const auto& f : other.m_cascade) {
                     m_cascade.push_back(f->clone());
                 }
+                prepare_scratch();
+#ifdef AF_CASCADE_PROFILING
+                m_profile.resize(m_cascade.size());
+                m_profiling = other.m_profiling;
+#endif
             }
 
             /**
              * @brief Filtering function overriden from Base Filter. Allows to filter in cascade each sample.
+             * * Rate changing stages filter without rate change here, use process() for multirate cascade.
              * @tparam Numerical input is signal sample given to the cascade.
              * @return Returns filtered samle in the same type as input.
              */
             T filter(T input) override{
+                AF_RT_SCOPE();
                 T output = input;
 
+#ifdef AF_CASCADE_PROFILING
+                if (m_profiling) {
+                    for(std::size_t i = 0; i < m_cascade.size(); i++){
+                        std::uint64_t start = read_cycles();
+                        output = m_cascade[i]->filter(output);
+                        m_profile[i].record(&output, 1, read_cycles() - start);
+                    }
+
+                    return output;
+                }
+#endif
+
                 for(auto& f : m_cascade){
                     output = f->filter(output);
                 }
@@ -54,6 +153,212 @@ namespace af{
                 return output;
             }
 
+            /**
+             * @brief Block filtering function overriden from Base Filter. Block is split into tiles (see get_tile_length())
+             * * and each tile goes through all stages in turn before next tile, so tile stays in cache between stages.
+             * * Every stage applies it's pending coeffitient updates at the start of each tile.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+
+                if (m_cascade.empty()) {
+                    if (input != output) {
+                        std::copy(input, input + length, output);
+                    }
+                    return;
+                }
+
+                const std::size_t tile = get_tile_length();
+                for (std::size_t done = 0; done < length; done += tile) {
+                    const std::size_t count = std::min(tile, length - done);
+                    const T* stage_input = input + done;
+                    T* stage_output = output + done;
+
+#ifdef AF_CASCADE_PROFILING
+                    if (m_profiling) {
+                        for(std::size_t i = 0; i < m_cascade.size(); i++){
+                            std::uint64_t start = read_cycles();
+                            m_cascade[i]->filter_block(stage_input, stage_output, count);
+                            m_profile[i].record(stage_output, count, read_cycles() - start);
+                            stage_input = stage_output;
+                        }
+                        continue;
+                    }
+#endif
+
+                    for(auto& f : m_cascade){
+                        f->filter_block(stage_input, stage_output, count);
+                        stage_input = stage_output;
+                    }
+                }
+            }
+
+            /**
+             * @brief Block filtering with rate change of stages. Block is split into input tiles (see get_tile_length()) and each tile
+             * * goes through process() of all stages in turn, intermediate outputs are kept in buffers preallocated by add_filter().
+             * @param input Pointer to block of input samples.
+             * @param length Number of input samples.
+             * @param output Pointer to at least max_output(length) samples (can be the same as input if no stage raises rate).
+             * @return Returns number of written output samples.
+             */
+            std::size_t process(const T* input, std::size_t length, T* output) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+
+                if (m_cascade.empty()) {
+                    if (input != output) {
+                        std::copy(input, input + length, output);
+                    }
+                    return length;
+                }
+
+                std::size_t produced = 0;
+                for (std::size_t done = 0; done < length; done += m_scratch_tile) {
+                    std::size_t count = std::min(m_scratch_tile, length - done);
+                    const T* stage_input = input + done;
+
+                    for (std::size_t i = 0; i < m_cascade.size(); i++) {
+                        T* stage_output = (i + 1 == m_cascade.size()) ? output + produced : m_scratch.data() + (i % 2) * m_scratch_size;
+#ifdef AF_CASCADE_PROFILING
+                        if (m_profiling) {
+                            std::uint64_t start = read_cycles();
+                            count = m_cascade[i]->process(stage_input, count, stage_output);
+                            m_profile[i].record(stage_output, count, read_cycles() - start);
+                            stage_input = stage_output;
+                            continue;
+                        }
+#endif
+                        count = m_cascade[i]->process(stage_input, count, stage_output);
+                        stage_input = stage_output;
+                    }
+                    produced += count;
+                }
+
+                return produced;
+            }
+
+            /**
+             * @brief Sampling frequency of output of process() - output frequency of the last stage.
+             * @return Returns output sampling frequency in Hz (sampling frequency of cascade if it is empty).
+             */
+            double get_output_freq() const override {
+                return m_cascade.empty() ? this->get_sampling_freq() : m_cascade.back()->get_output_freq();
+            }
+
+            /**
+             * @brief Number of samples written by process() for given input length in the worst case.
+             * @param length Number of input samples.
+             * @return Returns size of output buffer needed by process().
+             */
+            std::size_t max_output(std::size_t length) const override {
+                if (m_cascade.empty()) {
+                    return length;
+                }
+
+                std::size_t produced = 0;
+                for (std::size_t done = 0; done < length; done += m_scratch_tile) {
+                    std::size_t count = std::min(m_scratch_tile, length - done);
+                    for (const auto& f : m_cascade) {
+                        count = f->max_output(count);
+                    }
+                    produced += count;
+                }
+                return produced;
+            }
+
+            /**
+             * @brief Checks if any stage runs at other sampling frequency than input of cascade.
+             * @return Returns true if cascade changes rate.
+             */
+            bool is_multirate() const {
+                for (const auto& f : m_cascade) {
+                    if (f->get_sampling_freq() != this->get_sampling_freq() || f->get_output_freq() != this->get_sampling_freq()) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /**
+             * @brief Setter of tile length used by filter_block() and process().
+             * @param length Number of samples in tile, 0 for automatic choice (default).
+             */
+            void set_tile_length(std::size_t length) {
+                m_tile_length = length;
+                prepare_scratch();
+            }
+
+            /**
+             * @brief Getter of tile length used by filter_block().
+             * * Automatic tile takes half of 32 kB L1 data cache, or less if coeffitients and state of all stages
+             * * (estimated as twice their state size) would not fit into 256 kB L2 cache together with the tile. At least 64 samples.
+             * @return Returns number of samples in tile.
+             */
+            std::size_t get_tile_length() const {
+                if (m_tile_length > 0) {
+                    return m_tile_length;
+                }
+
+                const std::size_t l1_size = 32 * 1024;
+                const std::size_t l2_size = 256 * 1024;
+                std::size_t stages_size = 0;
+                for(const auto& f : m_cascade){
+                    stages_size += 2 * f->state_size();
+                }
+
+                std::size_t tile_size = l1_size / 2;
+                if (stages_size + tile_size > l2_size) {
+                    tile_size = stages_size < l2_size ? (l2_size - stages_size) / 2 : 0;
+                }
+
+                return std::max<std::size_t>(64, tile_size / sizeof(T) / 16 * 16);
+            }
+
+            /**
+             * @brief Strided in-place filtering overriden from Base Filter. Channel goes through each stage in turn, without copy.
+             * @param data Pointer to first sample of the channel.
+             * @param stride Distance between samples of the channel.
+             * @param length Number of samples of the channel.
+             */
+            void filter_block_strided(T* data, std::size_t stride, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+
+                for(auto& f : m_cascade){
+                    f->filter_block_strided(data, stride, length);
+                }
+            }
+
+            /**
+             * @brief Sets flushing of tiny state values for cascade and each filter in it.
+             * @param flush True to enable flushing, false to disable.
+             */
+            void set_flush_denormals(bool flush) override {
+                Base_Filter<T>::set_flush_denormals(flush);
+
+                for(auto& f : m_cascade){
+                    f->set_flush_denormals(flush);
+                }
+            }
+
+            /**
+             * @brief Getter of size of binary state of cascade (see Base_Filter::save_state()).
+             * @return Returns number of bytes needed to save state of all stages.
+             */
+            std::size_t state_size() const override {
+                std::size_t size = sizeof(std::uint32_t);
+
+                for(const auto& f : m_cascade){
+                    size += f->state_size();
+                }
+
+                return size;
+            }
+
             /**
              * @brief Resets each filter in cascaden (internal filter memory reset)
              */
@@ -62,21 +367,173 @@ namespace af{
                     f->reset();
                 }
             }
+
+            /**
+             * @brief Group delay of cascade at given frequency - sum of group delays of all stages.
+             * * Delays of stages running at other rate are converted to samples at input rate of cascade.
+             * @param freq Double type frequency in Hz.
+             * @return Returns group delay in samples.
+             */
+            double group_delay(double freq) const override {
+                double delay = 0.0;
+                for (const auto& f : m_cascade) {
+                    delay += f->group_delay(freq) * delay_scale(*f);
+                }
+                return delay;
+            }
+
+            /**
+             * @brief Latency of cascade - sum of latencies of all stages (tiling of blocks adds no delay).
+             * * Latencies of stages running at other rate are converted to samples at input rate of cascade.
+             * @return Returns latency in samples.
+             */
+            double get_latency() const override {
+                double latency = 0.0;
+                for (const auto& f : m_cascade) {
+                    latency += f->get_latency() * delay_scale(*f);
+                }
+                return latency;
+            }
+
+            /**
+             * @brief Frequency response of cascade at arbitrary frequencies - product of responses of all stages.
+             * * Each stage is evaluated at it's own rate, aliasing of rate changing stages is not included.
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override {
+                std::vector<std::complex<double>> stage(count);
+                std::fill(response, response + count, std::complex<double>(1.0));
+                for (const auto& f : m_cascade) {
+                    f->frequency_response(freq, stage.data(), count);
+                    for (std::size_t i = 0; i < count; i++) {
+                        response[i] *= stage[i];
+                    }
+                }
+            }
+
+            /**
+             * @brief Frequency response of cascade at n_points evenly spaced frequencies - product of responses of all stages
+             * * (each stage uses it's own fastest method, FFT for FIR and IIR).
+             * @param n_points Number of frequencies.
+             * @return Returns vector of H values.
+             */
+            std::vector<std::complex<double>> frequency_response(std::size_t n_points) const override {
+                if (is_multirate()) {
+                    return Base_Filter<T>::frequency_response(n_points);
+                }
+
+                std::vector<std::complex<double>> response(n_points, std::complex<double>(1.0));
+                for (const auto& f : m_cascade) {
+                    std::vector<std::complex<double>> stage = f->frequency_response(n_points);
+                    for (std::size_t k = 0; k < n_points; k++) {
+                        response[k] *= stage[k];
+                    }
+                }
+                return response;
+            }
             
             /**
-             * @brief Method for adding filter to the cascade. Sampling frequency must be the same for each filter in cascade. Returns true if succesful, false. if negative.
+             * @brief Method for adding filter to the cascade. Sampling frequency of filter must be the output frequency of cascade
+             * * (see get_output_freq()), the same as for every filter if no stage changes rate. Returns true if succesful, false. if negative.
              *  @param filter Any filter or cascade inheriting after Base Filter.
              *  @return Returns true if adding filter succesful. Otherwise retuns false.
              */
             bool add_filter(const Base_Filter<T>& filter) {
-                if (filter.get_sampling_freq() == this->get_sampling_freq()) {
+                if (filter.get_sampling_freq() == get_output_freq()) {
                     m_cascade.push_back(filter.clone());
+                    prepare_scratch();
+#ifdef AF_CASCADE_PROFILING
+                    m_profile.emplace_back();
+#endif
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Method for adding filter to the cascade, taking ownership of it (no clone). Sampling frequency of filter must be
+             * * the output frequency of cascade (see get_output_freq()).
+             *  @param filter Unique pointer to any filter or cascade inheriting after Base Filter.
+             *  @return Returns true if adding filter succesful. Otherwise retuns false.
+             */
+            bool add_filter(std::unique_ptr<Base_Filter<T>> filter) {
+                if (filter && filter->get_sampling_freq() == get_output_freq()) {
+                    m_cascade.push_back(std::move(filter));
+                    prepare_scratch();
+#ifdef AF_CASCADE_PROFILING
+                    m_profile.emplace_back();
+#endif
                     return true;
                 }
 
                 return false;
             }
+
+            /**
+             * @brief Getter of number of stages in cascade.
+             * @return Returns number of filters (or cascades) in cascade.
+             */
+            std::size_t size() const {
+                return m_cascade.size();
+            }
+
+            /**
+             * @brief Getter of a stage of cascade.
+             * @param index Index of stage, must be smaller than size().
+             * @return Returns reference to filter (or cascade) at given position.
+             */
+            const Base_Filter<T>& get_filter(std::size_t index) const {
+                return *m_cascade[index];
+            }
             
+            /**
+             * @brief Enables or disables per-stage profiling (samples, time, max block time, output peak and RMS of each stage).
+             * * Needs AF_CASCADE_PROFILING defined at compile time, otherwise counters are compiled out and this method does nothing.
+             * * Overhead measured by dsp_bench_profile (x86-64 VM, biquad stages): filter_block() about 3 ns per sample and stage (mostly peak/RMS),
+             * * filter() about 45 ns per sample and stage (two counter reads). Disabled at run time it costs one branch per call.
+             * @param enable True to collect counters, false to stop collecting (counters are kept).
+             * @return Returns false if profiling is compiled out.
+             */
+            bool set_profiling(bool enable) {
+#ifdef AF_CASCADE_PROFILING
+                m_profiling = enable;
+                return true;
+#else
+                (void)enable;
+                return false;
+#endif
+            }
+
+            /**
+             * @brief Getter of profiling counters of stages, named by get_filter_name() of each stage.
+             * * Nested cascade is one stage here, it's own stages can be profiled through it.
+             * @return Returns vector of counters, one for each stage (empty if profiling is compiled out).
+             */
+            std::vector<Stage_Profile> get_profile() const {
+                std::vector<Stage_Profile> profile;
+#ifdef AF_CASCADE_PROFILING
+                profile = m_profile;
+                for (std::size_t i = 0; i < profile.size(); i++) {
+                    profile[i].name = m_cascade[i]->get_filter_name();
+                }
+#endif
+                return profile;
+            }
+
+            /**
+             * @brief Sets all profiling counters to 0.
+             */
+            void reset_profile() {
+#ifdef AF_CASCADE_PROFILING
+                for (Stage_Profile& stage : m_profile) {
+                    stage = Stage_Profile();
+                }
+#endif
+            }
+
             /**
              * @brief Method for cloning it's self - cascade can be used to make bigger cascade
              * @return Returns unique pointer for new Cascade object.
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+namespace af{
+
+    /**
+     * @brief Helpers for compact binary filter state (see Base_Filter::save_state()).
+     * * State of every filter starts with 32-bit count used to check that state matches filter configuration.
+     */
+
+    /**
+     * @brief Writes count of state values.
+     * @param buffer Position in state buffer.
+     * @param count Count to write.
+     * @return Returns position after written count.
+     */
+    inline unsigned char* state_put_count(unsigned char* buffer, std::uint32_t count) {
+        std::memcpy(buffer, &count, sizeof(count));
+        return buffer + sizeof(count);
+    }
+
+    /**
+     * @brief Writes state values.
+     * @param buffer Position in state buffer.
+     * @param data Pointer to values.
+     * @param count Number of values.
+     * @return Returns position after written values.
+     */
+    template <typename T>
+    unsigned char* state_put(unsigned char* buffer, const T* data, std::size_t count) {
+        if (count > 0) {
+            std::memcpy(buffer, data, count * sizeof(T));
+        }
+        return buffer + count * sizeof(T);
+    }
+
+    /**
+     * @brief Reads count of state values and checks it against expected one.
+     * @param buffer Position in state buffer, moved past the count.
+     * @param end End of state buffer.
+     * @param expected Count expected by filter configuration.
+     * @return Returns true if count was read and matches, otherwise false.
+     */
+    inline bool state_get_count(const unsigned char*& buffer, const unsigned char* end, std::uint32_t expected) {
+        std::uint32_t count;
+        if (static_cast<std::size_t>(end - buffer) < sizeof(count)) {
+            return false;
+        }
+
+        std::memcpy(&count, buffer, sizeof(count));
+        buffer += sizeof(count);
+        return count == expected;
+    }
+
+    /**
+     * @brief Reads state values into existing memory (no allocation).
+     * @param buffer Position in state buffer, moved past the values.
+     * @param end End of state buffer.
+     * @param data Pointer to memory for values.
+     * @param count Number of values.
+     * @return Returns true if values were read, false if buffer is too short.
+     */
+    template <typename T>
+    bool state_get(const unsigned char*& buffer, const unsigned char* end, T* data, std::size_t count) {
+        if (static_cast<std::size_t>(end - buffer) < count * sizeof(T)) {
+            return false;
+        }
+
+        if (count > 0) {
+            std::memcpy(data, buffer, count * sizeof(T));
+        }
+        buffer += count * sizeof(T);
+        return true;
+    }
+
+}
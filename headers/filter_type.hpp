@@ -1,6 +1,11 @@
 #pragma once
 
 #include "base_filter.hpp"
+#include "coeff_exchange.hpp"
+#include "response.hpp"
+#include "moving_average.hpp"
+#include <algorithm>
+#include <limits>
 
 namespace af{
 
@@ -13,9 +18,220 @@ namespace af{
     template <typename T>
     class FIR : public Base_Filter<T> {
         private:
-            std::vector<T> m_coeff;
+            Shared_Coeff<T> m_coeff;
             std::vector<T> m_past_sample;
+            Coeff_Exchange<T> m_exchange;
+            std::size_t m_fade_length = 0;
+            std::size_t m_fade_left = 0;
+            bool m_equal_coeff = false;
+            Sparse_Taps<T> m_taps;
+
+            /**
+             * @brief Helper checking if all coeffitients are equal (boxcar, see fast_form()).
+             * @param coeff Coeffitients of filter.
+             * @return Returns true if there are at least two coeffitients and all of them are equal.
+             */
+            static bool equal_coeff(const Shared_Coeff<T>& coeff) {
+                const T* c = coeff.data();
+                for (std::size_t i = 1; i < coeff.size(); i++) {
+                    if (c[i] != c[0]) {
+                        return false;
+                    }
+                }
+                return coeff.size() > 1;
+            }
+
+            /**
+             * @brief Helper finding structure of zero taps and packing nonzero taps for zero skipping kernel (see convolve_taps()).
+             * * Tap is zero if it's magnitude is not larger than epsilon of T times the largest tap (windowed designs leave
+             * * rounding noise instead of exact zeros). Short filters and filters with many nonzero taps keep dense kernel.
+             * @param coeff Coeffitients of filter.
+             * @param taps Filled with layout and packed taps (allocates, called only from control thread).
+             */
+            static void find_taps(const Shared_Coeff<T>& coeff, Sparse_Taps<T>& taps) {
+                const T* c = coeff.data();
+                const std::size_t size = coeff.size();
+                taps.layout = Tap_Layout::Dense;
+                taps.value.clear();
+                taps.index.clear();
+                if (size < 8) {
+                    return;
+                }
+
+                T peak = static_cast<T>(0);
+                for (std::size_t i = 0; i < size; i++) {
+                    peak = std::max(peak, static_cast<T>(std::fabs(c[i])));
+                }
+                const T tolerance = peak * std::numeric_limits<T>::epsilon();
+
+                std::size_t nonzero[2] = {0, 0};
+                for (std::size_t i = 0; i < size; i++) {
+                    nonzero[i % 2] += std::fabs(c[i]) > tolerance ? 1 : 0;
+                }
+
+                const std::size_t center = (size - 1) / 2;
+                if (nonzero[0] == 0 || nonzero[1] == 0) {
+                    taps.layout = Tap_Layout::Alternating;
+                    taps.first = nonzero[0] == 0 ? 1 : 0;
+                }
+                else if (size % 2 == 1 && nonzero[center % 2] == 1 && std::fabs(c[center]) > tolerance) {
+                    taps.layout = Tap_Layout::Halfband;
+                    taps.first = (center + 1) % 2;
+                    taps.center = center;
+                    taps.center_value = c[center];
+                }
+                else if (4 * (nonzero[0] + nonzero[1]) <= size) {
+                    // gather kernel does not vectorize, so it pays off only for a quarter of taps or less
+                    taps.layout = Tap_Layout::Sparse;
+                    for (std::size_t i = 0; i < size; i++) {
+                        if (std::fabs(c[i]) > tolerance) {
+                            taps.value.push_back(c[i]);
+                            taps.index.push_back(static_cast<std::uint32_t>(i));
+                        }
+                    }
+                    return;
+                }
+                else {
+                    return;
+                }
+
+                for (std::size_t i = taps.first; i < size; i += 2) {
+                    taps.value.push_back(c[i]);
+                }
+            }
+
+            /**
+             * @brief Helper computing sum of products of given coeffitients and filter memory.
+             * @param coeff Coeffitients of the same size as filter memory.
+             * @return Returns output sample for given coeffitients.
+             */
+            T convolve(const Shared_Coeff<T>& coeff) const{
+                const T* c = coeff.data();
+                const T* x = m_past_sample.data();
+                T output = static_cast<T>(0);
+
+                for (size_t i = 0; i< coeff.size(); i++){
+                    output += c[i] * x[i];
+                }
+
+                return output;
+            }
+
+            /**
+             * @brief Helper computing output for current coeffitients with kernel selected by find_taps() (only nonzero taps are multiplied).
+             * @return Returns output sample.
+             */
+            T convolve_taps() const{
+                const T* v = m_taps.value.data();
+                const std::size_t count = m_taps.value.size();
+                T output = static_cast<T>(0);
+
+                switch (m_taps.layout) {
+                    case Tap_Layout::Alternating:
+                    case Tap_Layout::Halfband: {
+                        const T* x = m_past_sample.data() + m_taps.first;
+                        for (std::size_t k = 0; k < count; k++) {
+                            output += v[k] * x[2 * k];
+                        }
+                        if (m_taps.layout == Tap_Layout::Halfband) {
+                            output += m_taps.center_value * m_past_sample[m_taps.center];
+                        }
+                        return output;
+                    }
+                    case Tap_Layout::Sparse: {
+                        const T* x = m_past_sample.data();
+                        const std::uint32_t* index = m_taps.index.data();
+                        for (std::size_t k = 0; k < count; k++) {
+                            output += v[k] * x[index[k]];
+                        }
+                        return output;
+                    }
+                    default:
+                        return convolve(m_coeff);
+                }
+            }
  
+        protected:
+
+            /**
+             * @brief Shifts input sample into filter memory without computing output (decimators skip outputs, see Decimator).
+             * @param input Input sample.
+             */
+            void push_sample(T input) {
+                for(int i = m_past_sample.size()-1 ; i > 0; i--){
+                    m_past_sample[i] = m_past_sample[i-1];
+                }
+
+                m_past_sample[0] = this->get_flush_denormals() ? flush_tiny(input) : input;
+            }
+
+            /**
+             * @brief Shifts count input samples into filter memory by one move, cost does not grow with count (decimators push
+             * * factor samples per output, see Decimator). Same memory as count calls of push_sample().
+             * @param input Pointer to input samples, oldest first.
+             * @param count Number of input samples.
+             */
+            void push_samples(const T* input, std::size_t count) {
+                const std::size_t size = m_past_sample.size();
+                T* x = m_past_sample.data();
+                if (count < size) {
+                    std::copy_backward(x, x + size - count, x + size);
+                }
+                else {
+                    input += count - size;
+                    count = size;
+                }
+
+                const bool flush = this->get_flush_denormals();
+                for (std::size_t k = 0; k < count; k++) {
+                    const T sample = input[count - 1 - k];
+                    x[k] = flush ? flush_tiny(sample) : sample;
+                }
+            }
+
+            /**
+             * @brief Computes output for current filter memory (crossfade advances by one output sample).
+             * @return Returns output sample.
+             */
+            T output_sample() {
+                if (m_fade_left > 0) {
+                    T gain = static_cast<T>(m_fade_left) / static_cast<T>(m_fade_length);
+                    m_fade_left--;
+                    return gain * convolve(m_exchange.front().coeff_b) + (static_cast<T>(1) - gain) * convolve(m_coeff);
+                }
+
+                return convolve_taps();
+            }
+
+            /**
+             * @brief Writes filter memory as binary state (see Base_Filter::save_state()).
+             * @param buffer Pointer to state buffer of at least state_size() bytes.
+             * @return Returns number of written bytes.
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                unsigned char* position = state_put_count(buffer, static_cast<std::uint32_t>(m_past_sample.size()));
+                position = state_put(position, m_past_sample.data(), m_past_sample.size());
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads filter memory from binary state into existing memory (see Base_Filter::load_state()).
+             * @param buffer Pointer to state buffer.
+             * @param size Number of bytes available in buffer.
+             * @return Returns number of read bytes, 0 if state does not match order of filter.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                const unsigned char* end = buffer + size;
+
+                if (!state_get_count(position, end, static_cast<std::uint32_t>(m_past_sample.size()))
+                    || !state_get(position, end, m_past_sample.data(), m_past_sample.size())) {
+                    return 0;
+                }
+
+                return position - buffer;
+            }
+
         public:
 
             /**
@@ -34,6 +250,14 @@ namespace af{
                 set_coeff(coeffitients);
             }
 
+            /**
+             * @brief Parametric constructor for FIR object without coeffitients (to be set later by set_coeff()).
+             * * Used by designed filters, so they don't build and throw away placeholder coeffitients.
+             * @param sampling_freq Double type sampling frequency of samples to be filtered.
+             * @param filter_name String type name of FIR.
+             */
+            FIR(double sampling_freq, std::string filter_name) : Base_Filter<T>(sampling_freq, filter_name) {}
+
             /**
              * @brief Virtual destrutor of FIR object.
              */
@@ -45,6 +269,24 @@ namespace af{
              * @return Returns true if setting succesful, otherwise false. (vector cannot be empty) 
              */
             bool set_coeff(const std::vector<T>& coeff) {
+                return set_coeff(Shared_Coeff<T>(coeff));
+            }
+
+            /**
+             * @brief Setter of coeffitients to a FIR filter, taking ownership of given vector (no copy).
+             * @param coeff Vector (numerical type) of coeffitients. 
+             * @return Returns true if setting succesful, otherwise false. (vector cannot be empty) 
+             */
+            bool set_coeff(std::vector<T>&& coeff) {
+                return set_coeff(Shared_Coeff<T>(std::move(coeff)));
+            }
+
+            /**
+             * @brief Setter of shared coeffitients to a FIR filter. Filter keeps reference, coeffitients are not copied.
+             * @param coeff Shared coeffitients (for example from Design_Cache).
+             * @return Returns true if setting succesful, otherwise false. (coeffitients cannot be empty) 
+             */
+            bool set_coeff(const Shared_Coeff<T>& coeff) {
                 if(coeff.empty()) {
                     return false;
                 }
@@ -52,6 +294,71 @@ namespace af{
                 else{
                     m_coeff = coeff;
                     m_past_sample = std::vector<T>(m_coeff.size(), static_cast<T>(0)); //anonimo objcetto 
+                    m_fade_left = 0;
+                    m_equal_coeff = equal_coeff(m_coeff);
+                    find_taps(m_coeff, m_taps);
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Thread safe request of new coeffitients, to be called from control thread.
+             * * Coeffitients are copied to preallocated slot and swapped in at the start of next block (see apply_pending_coeff()).
+             * * Only one control thread may call this method for given filter.
+             * @param coeff Vector (numerical type) of coeffitients.
+             * @param crossfade Number of samples for interpolation between old and new response (0 - instant switch). Used only if order is unchanged.
+             * @return Returns true if request was published, otherwise false. (vector cannot be empty)
+             */
+            bool request_coeff(const std::vector<T>& coeff, std::size_t crossfade = 0) {
+                return request_coeff(Shared_Coeff<T>(coeff), crossfade);
+            }
+
+            /**
+             * @brief Thread safe request of new shared coeffitients, to be called from control thread (see request_coeff()).
+             * @param coeff Shared coeffitients.
+             * @param crossfade Number of samples for interpolation between old and new response (0 - instant switch).
+             * @return Returns true if request was published, otherwise false. (coeffitients cannot be empty)
+             */
+            bool request_coeff(const Shared_Coeff<T>& coeff, std::size_t crossfade = 0) {
+                if(coeff.empty()) {
+                    return false;
+                }
+
+                Coeff_Slot<T>& slot = m_exchange.back();
+                slot.coeff_b = coeff;
+                slot.past_input.assign(coeff.size(), static_cast<T>(0));
+                slot.crossfade = crossfade;
+                find_taps(coeff, slot.taps);
+                m_exchange.publish();
+
+                return true;
+            }
+
+            /**
+             * @brief Swaps in coeffitients published by request_coeff(). Called by filter_block() at every block boundary.
+             * * Never allocates. Memory is kept when order is unchanged, otherwise newest samples are moved to resized memory.
+             * * Update waits while crossfade of previous update is still running.
+             * @return Returns true if new coeffitients were applied, otherwise false.
+             */
+            bool apply_pending_coeff() {
+                if (m_fade_left > 0 || !m_exchange.fetch()) {
+                    return false;
+                }
+
+                Coeff_Slot<T>& slot = m_exchange.front();
+                std::swap(m_coeff, slot.coeff_b);
+                std::swap(m_taps, slot.taps);
+                m_equal_coeff = equal_coeff(m_coeff);
+
+                if (slot.past_input.size() != m_past_sample.size()) {
+                    std::size_t keep = std::min(slot.past_input.size(), m_past_sample.size());
+                    std::copy(m_past_sample.begin(), m_past_sample.begin() + keep, slot.past_input.begin());
+                    m_past_sample.swap(slot.past_input);
+                }
+                else if (slot.crossfade > 0) {
+                    m_fade_length = slot.crossfade;
+                    m_fade_left = slot.crossfade;
                 }
 
                 return true;
@@ -59,12 +366,126 @@ namespace af{
 
             /**
              * @brief Getter of filters coeffitients.
-             * @return Retutrns vector of coeffitiens.
+             * @return Retutrns shared coeffitiens (convertible to vector).
              */
-            const std::vector<T>& get_coeff() const{
+            const Shared_Coeff<T>& get_coeff() const{
                 return m_coeff;
             }
 
+            /**
+             * @brief Getter of kernel selected for current coeffitients (detected by set_coeff() and request_coeff()).
+             * * Halfband and alternating layouts multiply only every other tap, Sparse layout only nonzero taps.
+             * @return Returns layout of zero taps.
+             */
+            Tap_Layout get_tap_layout() const{
+                return m_taps.layout;
+            }
+
+            /**
+             * @brief Getter of number of multiplications per output sample of current kernel.
+             * @return Returns number of nonzero taps (all taps for Dense layout).
+             */
+            std::size_t get_active_taps() const{
+                if (m_taps.layout == Tap_Layout::Dense) {
+                    return m_coeff.size();
+                }
+                return m_taps.value.size() + (m_taps.layout == Tap_Layout::Halfband ? 1 : 0);
+            }
+
+            /**
+             * @brief Checks if coeffitients are all equal (detected by set_coeff() and apply_pending_coeff()).
+             * * Such filter is moving average and fast_form() replaces it by running sum with O(1) cost per sample.
+             * @return Returns true if filter has at least two equal coeffitients.
+             */
+            bool is_moving_average() const{
+                return m_equal_coeff;
+            }
+
+            /**
+             * @brief Builds equivalent filter with the cheapest kernel, to be used instead of this one (for example in Cascade).
+             * * FIR with equal coeffitients becomes MovingAverage with the same memory, otherwise copy of FIR is returned.
+             * @return Returns new filter with the same response, name and sampling frequency.
+             */
+            std::unique_ptr<Base_Filter<T>> fast_form() const{
+                if (!m_equal_coeff) {
+                    return clone();
+                }
+
+                auto average = std::make_unique<MovingAverage<T>>(this->get_sampling_freq(), this->get_filter_name(), m_coeff.size(), m_coeff.data()[0]);
+                average->set_flush_denormals(this->get_flush_denormals());
+                for (std::size_t i = m_past_sample.size(); i-- > 0;) {
+                    average->filter(m_past_sample[i]);
+                }
+                return average;
+            }
+
+            /**
+             * @brief Group delay of filter at given frequency (see poly_response()).
+             * @param freq Double type frequency in Hz.
+             * @return Returns group delay in samples.
+             */
+            double group_delay(double freq) const override{
+                return poly_response(m_coeff.data(), m_coeff.size(), 2.0 * M_PI * freq / this->get_sampling_freq()).delay;
+            }
+
+            /**
+             * @brief Latency of filter. Symmetric and antisymmetric (linear phase) coeffitients give exact (number of taps - 1) / 2,
+             * * other coeffitients (for example minimum phase) give group delay averaged over passband (see passband_latency()).
+             * @return Returns latency in samples.
+             */
+            double get_latency() const override{
+                const T* coeff = m_coeff.data();
+                const std::size_t size = m_coeff.size();
+                if (size == 0) {
+                    return 0.0;
+                }
+
+                double peak = 0.0;
+                for (std::size_t i = 0; i < size; i++) {
+                    peak = std::max(peak, std::fabs(static_cast<double>(coeff[i])));
+                }
+
+                const double tolerance = 1e-6 * peak;
+                bool symmetric = true;
+                bool antisymmetric = true;
+                for (std::size_t i = 0; i < size / 2; i++) {
+                    double first = static_cast<double>(coeff[i]);
+                    double last = static_cast<double>(coeff[size - 1 - i]);
+                    symmetric = symmetric && std::fabs(first - last) <= tolerance;
+                    antisymmetric = antisymmetric && std::fabs(first + last) <= tolerance;
+                }
+
+                if (symmetric || antisymmetric) {
+                    return 0.5 * static_cast<double>(size - 1);
+                }
+                return passband_latency([&](double omega) { return poly_response(coeff, size, omega); });
+            }
+
+            /**
+             * @brief Frequency response at arbitrary frequencies, evaluated from coeffitients (see poly_response_batch()).
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override{
+                std::vector<double> omega(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    omega[i] = 2.0 * M_PI * freq[i] / this->get_sampling_freq();
+                }
+                poly_response_batch(m_coeff.data(), m_coeff.size(), omega.data(), response, count);
+            }
+
+            /**
+             * @brief Frequency response at n_points evenly spaced frequencies k * fs / (2 n_points) by FFT of coeffitients (see poly_response_grid()).
+             * @param n_points Number of frequencies (power of two uses FFT).
+             * @return Returns vector of H values.
+             */
+            std::vector<std::complex<double>> frequency_response(std::size_t n_points) const override{
+                std::vector<std::complex<double>> response(n_points);
+                poly_response_grid(m_coeff.data(), m_coeff.size(), response.data(), n_points);
+                return response;
+            }
+
             /**
              * @brief Getter of filters memory.
              * @return Retutrns vector of samples in memory.
@@ -73,32 +494,69 @@ namespace af{
                 return m_past_sample;
             }
 
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             * @return Returns number of bytes needed to save filter memory.
+             */
+            std::size_t state_size() const override{
+                return sizeof(std::uint32_t) + m_past_sample.size() * sizeof(T);
+            }
+
             /**
              * @brief Method for reseting filter memory.
              */
             void reset() override{
-                m_past_sample = std::vector<T>(m_coeff.size(), static_cast<T>(0));
+                std::fill(m_past_sample.begin(), m_past_sample.end(), static_cast<T>(0));
+                m_fade_left = 0;
             }
 
             /**
              * @brief Method for filtering a sample of input signal for FIR filters.
-             * * Filters one sample at a time for flexibility in using.
+             * * Filters one sample at a time for flexibility in using. FIR without coeffitients (for example result
+             * * of design with invalid specification) passes samples unchanged.
              * @tparam Numerical type input sample.
              * @return Filtered numerical type input sample (same as input type).
              */
             T filter(T input) override{
-                for(int i = m_past_sample.size()-1 ; i > 0; i--){
-                    m_past_sample[i] = m_past_sample[i-1];
+                AF_RT_SCOPE();
+                if (m_past_sample.empty()) {
+                    return input;
                 }
 
-                m_past_sample[0] = input;
-                T output = static_cast<T>(0);
+                push_sample(input);
+                return output_sample();
+            }
+
+            /**
+             * @brief Method for filtering a block of samples. Pending coeffitients are applied before first sample.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                apply_pending_coeff();
 
-                for (size_t i = 0; i< m_coeff.size(); i++){
-                    output += m_coeff[i] * m_past_sample[i];
+                for (std::size_t i = 0; i < length; i++){
+                    output[i] = FIR<T>::filter(input[i]);
                 }
+            }
 
-                return output;
+            /**
+             * @brief Method for filtering in place one channel of strided buffer. Pending coeffitients are applied before first sample.
+             * @param data Pointer to first sample of the channel.
+             * @param stride Distance between samples of the channel.
+             * @param length Number of samples of the channel.
+             */
+            void filter_block_strided(T* data, std::size_t stride, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                apply_pending_coeff();
+
+                for (std::size_t i = 0; i < length; i++, data += stride){
+                    *data = FIR<T>::filter(*data);
+                }
             }
 
             /**
@@ -122,10 +580,72 @@ namespace af{
     template <typename T>
     class IIR : public Base_Filter<T> {
         private:
-            std::vector<T> m_coeff_b;
-            std::vector<T> m_coeff_a;
+            Shared_Coeff<T> m_coeff_b;
+            Shared_Coeff<T> m_coeff_a;
             std::vector<T> m_past_input;
             std::vector<T> m_past_output;
+            Coeff_Exchange<T> m_exchange;
+            std::size_t m_fade_length = 0;
+            std::size_t m_fade_left = 0;
+
+            /**
+             * @brief Helper computing difference equation for given coeffitients and filter memory.
+             * @param coeff_b Coeffitients b of the same size as input memory.
+             * @param coeff_a Coeffitients a, one shorter than output memory.
+             * @return Returns output sample for given coeffitients.
+             */
+            T difference(const Shared_Coeff<T>& coeff_b, const Shared_Coeff<T>& coeff_a) const{
+                const T* b = coeff_b.data();
+                const T* a = coeff_a.data();
+                const T* x = m_past_input.data();
+                const T* y = m_past_output.data();
+                T output = static_cast<T>(0);
+                for (size_t i = 0; i < coeff_b.size(); i++) {
+                    output += b[i] * x[i];
+                }
+
+                for (size_t i = 0; i < coeff_a.size(); i++) {
+                    output -= a[i] * y[i + 1];
+                }
+
+                return output;
+            }
+
+        protected:
+
+            /**
+             * @brief Writes filter input and output memory as binary state (see Base_Filter::save_state()).
+             * @param buffer Pointer to state buffer of at least state_size() bytes.
+             * @return Returns number of written bytes.
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                unsigned char* position = state_put_count(buffer, static_cast<std::uint32_t>(m_past_input.size()));
+                position = state_put_count(position, static_cast<std::uint32_t>(m_past_output.size()));
+                position = state_put(position, m_past_input.data(), m_past_input.size());
+                position = state_put(position, m_past_output.data(), m_past_output.size());
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads filter memory from binary state into existing memory (see Base_Filter::load_state()).
+             * @param buffer Pointer to state buffer.
+             * @param size Number of bytes available in buffer.
+             * @return Returns number of read bytes, 0 if state does not match order of filter.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                const unsigned char* end = buffer + size;
+
+                if (!state_get_count(position, end, static_cast<std::uint32_t>(m_past_input.size()))
+                    || !state_get_count(position, end, static_cast<std::uint32_t>(m_past_output.size()))
+                    || !state_get(position, end, m_past_input.data(), m_past_input.size())
+                    || !state_get(position, end, m_past_output.data(), m_past_output.size())) {
+                    return 0;
+                }
+
+                return position - buffer;
+            }
+
         public:
 
             /**
@@ -145,6 +665,13 @@ namespace af{
                 set_coeff(coeffitients_b, coeffitients_a);
             }
 
+            /**
+             * @brief Parametric constructor for IIR object without coeffitients (to be set later by set_coeff()).
+             * @param sampling_freq Double type sampling frequency of samples to be filtered.
+             * @param filter_name String type name of IIR.
+             */
+            IIR(double sampling_freq, std::string filter_name) : Base_Filter<T>(sampling_freq, filter_name) {}
+
             /**
             * @brief Virtual destrutor of IIR object.
             */
@@ -157,6 +684,16 @@ namespace af{
              * @return Returns true if setting succesful, otherwise false. (vectors cannot be empty) 
              */
             bool set_coeff(const std::vector<T>& coeff_b, const std::vector<T>& coeff_a) {
+                return set_coeff(Shared_Coeff<T>(coeff_b), Shared_Coeff<T>(coeff_a));
+            }
+
+            /**
+             * @brief Setter of shared coeffitients to a IIR filter. Filter keeps reference, coeffitients are not copied.
+             * @param coeff_b Shared coeffitients b (for example from Design_Cache).
+             * @param coeff_a Shared coeffitients a.
+             * @return Returns true if setting succesful, otherwise false. (coeffitients cannot be empty) 
+             */
+            bool set_coeff(const Shared_Coeff<T>& coeff_b, const Shared_Coeff<T>& coeff_a) {
                 if(coeff_b.empty()||coeff_a.empty()) {
                     return false;
                 }
@@ -166,27 +703,152 @@ namespace af{
                     m_coeff_a = coeff_a;
                     m_past_input = std::vector<T>(m_coeff_b.size(), static_cast<T>(0)); //anonimo objcetto 
                     m_past_output = std::vector<T>(m_coeff_a.size() + 1, static_cast<T>(0));
+                    m_fade_left = 0;
                 }
 
                 return true;
             }       
 
+            /**
+             * @brief Thread safe request of new coeffitients, to be called from control thread.
+             * * Coeffitients are copied to preallocated slot and swapped in at the start of next block (see apply_pending_coeff()).
+             * * Only one control thread may call this method for given filter.
+             * @param coeff_b Vector (numerical type) of coeffitients b.
+             * @param coeff_a Vector (numerical type) of coeffitients a.
+             * @param crossfade Number of samples for interpolation between old and new coeffitients (0 - instant switch). Used only if order is unchanged.
+             * @return Returns true if request was published, otherwise false. (vectors cannot be empty)
+             */
+            bool request_coeff(const std::vector<T>& coeff_b, const std::vector<T>& coeff_a, std::size_t crossfade = 0) {
+                return request_coeff(Shared_Coeff<T>(coeff_b), Shared_Coeff<T>(coeff_a), crossfade);
+            }
+
+            /**
+             * @brief Thread safe request of new shared coeffitients, to be called from control thread (see request_coeff()).
+             * @param coeff_b Shared coeffitients b.
+             * @param coeff_a Shared coeffitients a.
+             * @param crossfade Number of samples for interpolation between old and new coeffitients (0 - instant switch).
+             * @return Returns true if request was published, otherwise false. (coeffitients cannot be empty)
+             */
+            bool request_coeff(const Shared_Coeff<T>& coeff_b, const Shared_Coeff<T>& coeff_a, std::size_t crossfade = 0) {
+                if(coeff_b.empty()||coeff_a.empty()) {
+                    return false;
+                }
+
+                Coeff_Slot<T>& slot = m_exchange.back();
+                slot.coeff_b = coeff_b;
+                slot.coeff_a = coeff_a;
+                slot.past_input.assign(coeff_b.size(), static_cast<T>(0));
+                slot.past_output.assign(coeff_a.size() + 1, static_cast<T>(0));
+                slot.crossfade = crossfade;
+                m_exchange.publish();
+
+                return true;
+            }
+
+            /**
+             * @brief Swaps in coeffitients published by request_coeff(). Called by filter_block() at every block boundary.
+             * * Never allocates. Memory is kept when order is unchanged, otherwise newest samples are moved to resized memory.
+             * * Update waits while crossfade of previous update is still running.
+             * @return Returns true if new coeffitients were applied, otherwise false.
+             */
+            bool apply_pending_coeff() {
+                if (m_fade_left > 0 || !m_exchange.fetch()) {
+                    return false;
+                }
+
+                Coeff_Slot<T>& slot = m_exchange.front();
+                std::swap(m_coeff_b, slot.coeff_b);
+                std::swap(m_coeff_a, slot.coeff_a);
+                bool same_order = slot.past_input.size() == m_past_input.size() && slot.past_output.size() == m_past_output.size();
+
+                if (!same_order) {
+                    std::size_t keep_in = std::min(slot.past_input.size(), m_past_input.size());
+                    std::size_t keep_out = std::min(slot.past_output.size(), m_past_output.size());
+                    std::copy(m_past_input.begin(), m_past_input.begin() + keep_in, slot.past_input.begin());
+                    std::copy(m_past_output.begin(), m_past_output.begin() + keep_out, slot.past_output.begin());
+                    m_past_input.swap(slot.past_input);
+                    m_past_output.swap(slot.past_output);
+                }
+                else if (slot.crossfade > 0) {
+                    m_fade_length = slot.crossfade;
+                    m_fade_left = slot.crossfade;
+                }
+
+                return true;
+            }
+
             /**
              * @brief Getter of coefitienst a of IIR filter.
-             * @return Returns vector of coeffitiets.
+             * @return Returns shared coeffitiets (convertible to vector).
              */
-            const std::vector<T>& get_coeff_a() const{
+            const Shared_Coeff<T>& get_coeff_a() const{
                 return m_coeff_a;
             }
 
             /**
              * @brief Getter of coefitienst b of IIR filter.
-             * @return Returns vector of coeffitiets.
+             * @return Returns shared coeffitiets (convertible to vector).
              */
-            const std::vector<T>& get_coeff_b() const{
+            const Shared_Coeff<T>& get_coeff_b() const{
                 return m_coeff_b;
             }
 
+            /**
+             * @brief Group delay of filter at given frequency (see iir_response()).
+             * @param freq Double type frequency in Hz.
+             * @return Returns group delay in samples.
+             */
+            double group_delay(double freq) const override{
+                return iir_response(m_coeff_b.data(), m_coeff_b.size(), m_coeff_a.data(), m_coeff_a.size(),
+                                    2.0 * M_PI * freq / this->get_sampling_freq()).delay;
+            }
+
+            /**
+             * @brief Latency of filter, group delay averaged over passband (see passband_latency()).
+             * @return Returns latency in samples.
+             */
+            double get_latency() const override{
+                return passband_latency([&](double omega) {
+                    return iir_response(m_coeff_b.data(), m_coeff_b.size(), m_coeff_a.data(), m_coeff_a.size(), omega);
+                });
+            }
+
+            /**
+             * @brief Frequency response B / A at arbitrary frequencies, evaluated from coeffitients (see poly_response_batch()).
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override{
+                std::vector<double> omega(count);
+                std::vector<std::complex<double>> denominator(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    omega[i] = 2.0 * M_PI * freq[i] / this->get_sampling_freq();
+                }
+
+                poly_response_batch(m_coeff_b.data(), m_coeff_b.size(), omega.data(), response, count);
+                poly_response_batch(m_coeff_a.data(), m_coeff_a.size(), omega.data(), denominator.data(), count, true);
+                for (std::size_t i = 0; i < count; i++) {
+                    response[i] /= denominator[i];
+                }
+            }
+
+            /**
+             * @brief Frequency response B / A at n_points evenly spaced frequencies k * fs / (2 n_points) by FFT of coeffitients (see poly_response_grid()).
+             * @param n_points Number of frequencies (power of two uses FFT).
+             * @return Returns vector of H values.
+             */
+            std::vector<std::complex<double>> frequency_response(std::size_t n_points) const override{
+                std::vector<std::complex<double>> response(n_points);
+                std::vector<std::complex<double>> denominator(n_points);
+                poly_response_grid(m_coeff_b.data(), m_coeff_b.size(), response.data(), n_points);
+                poly_response_grid(m_coeff_a.data(), m_coeff_a.size(), denominator.data(), n_points, true);
+                for (std::size_t k = 0; k < n_points; k++) {
+                    response[k] /= denominator[k];
+                }
+                return response;
+            }
+
             /**
              * @brief Getter of filter's input memory.
              * @return Returns vector of input samples in memory.
@@ -203,44 +865,97 @@ namespace af{
                 return m_past_output;
             }
 
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             * @return Returns number of bytes needed to save filter memory.
+             */
+            std::size_t state_size() const override{
+                return 2 * sizeof(std::uint32_t) + (m_past_input.size() + m_past_output.size()) * sizeof(T);
+            }
+
             /**
              * @brief Method for reseting filter's internal memory.
              */
             void reset() override{
-                m_past_input = std::vector<T>(m_past_input.size(), static_cast<T>(0));
-                m_past_output = std::vector<T>(m_past_output.size(), static_cast<T>(0));
+                std::fill(m_past_input.begin(), m_past_input.end(), static_cast<T>(0));
+                std::fill(m_past_output.begin(), m_past_output.end(), static_cast<T>(0));
+                m_fade_left = 0;
             }
             
             /**
              * @brief Method for filtering a sample of input signal for IIR filters.
-             * * Filters one sample at a time for flexibility in using.
+             * * Filters one sample at a time for flexibility in using. IIR without coeffitients passes samples unchanged.
              * @tparam Numerical type input sample.
              * @return Filtered numerical type input sample (same as input type).
              */
             T filter(T input) override{
+                AF_RT_SCOPE();
+                if (m_past_input.empty()) {
+                    return input;
+                }
+
                 for(int i = m_past_input.size() - 1 ; i > 0; i--){
                     m_past_input[i] = m_past_input[i-1];
                 }                
-                m_past_input[0] = input;
+                m_past_input[0] = this->get_flush_denormals() ? flush_tiny(input) : input;
 
             
                 for (int i = m_past_output.size() - 1; i > 0; i--) {
                     m_past_output[i] = m_past_output[i - 1];
                 }
 
-                T output = static_cast<T>(0);
-                for (size_t i = 0; i < m_coeff_b.size(); i++) {
-                    output += m_coeff_b[i] * m_past_input[i];
+                T output;
+                if (m_fade_left > 0) {
+                    // output mix with shared memory equals linear interpolation of coeffitients
+                    Coeff_Slot<T>& old = m_exchange.front();
+                    T gain = static_cast<T>(m_fade_left) / static_cast<T>(m_fade_length);
+                    m_fade_left--;
+                    output = gain * difference(old.coeff_b, old.coeff_a) + (static_cast<T>(1) - gain) * difference(m_coeff_b, m_coeff_a);
+                }
+                else {
+                    output = difference(m_coeff_b, m_coeff_a);
                 }
 
-                for (size_t i = 0; i < m_coeff_a.size(); i++) {
-                    output -= m_coeff_a[i] * m_past_output[i + 1];
+                if (this->get_flush_denormals()) {
+                    output = flush_tiny(output);
                 }
 
                 m_past_output[0] = output;
                 return output;
             }
 
+            /**
+             * @brief Method for filtering a block of samples. Pending coeffitients are applied before first sample.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                apply_pending_coeff();
+
+                for (std::size_t i = 0; i < length; i++){
+                    output[i] = IIR<T>::filter(input[i]);
+                }
+            }
+
+            /**
+             * @brief Method for filtering in place one channel of strided buffer. Pending coeffitients are applied before first sample.
+             * @param data Pointer to first sample of the channel.
+             * @param stride Distance between samples of the channel.
+             * @param length Number of samples of the channel.
+             */
+            void filter_block_strided(T* data, std::size_t stride, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                apply_pending_coeff();
+
+                for (std::size_t i = 0; i < length; i++, data += stride){
+                    *data = IIR<T>::filter(*data);
+                }
+            }
+
             /**
              * @brief Method for cloning it's self - used to make cascades
              */
@@ -252,4 +967,456 @@ namespace af{
 
     };
 
+    /**
+     * @brief SOS class is IIR filter made of second order sections (biquads) kept in one contiguous bank.
+     * * Every section is stored as b0, b1, b2, a1, a2 (a0 = 1), so filter of order 2N holds 5N coeffitients and is numerically
+     * * stable also for high orders, where expanded polynomials of IIR lose precision.
+     * * All sections are processed by one fused loop sample by sample, output memory of one section is input memory
+     * * of the next one (direct form I), so the bank keeps only 2N + 2 samples of memory.
+     * @tparam T is type of numerical data to be used as input samples.
+     */
+    template <typename T>
+    class SOS : public Base_Filter<T> {
+        private:
+            Shared_Coeff<T> m_sections;
+            std::vector<T> m_memory;
+            Coeff_Exchange<T> m_exchange;
+            std::size_t m_fade_length = 0;
+            std::size_t m_fade_left = 0;
+
+            /**
+             * @brief Helper computing output of one section for given coeffitients and memory.
+             * @param c Pointer to b0, b1, b2, a1, a2 of section.
+             * @param input Input sample of section.
+             * @param memory Pointer to two past inputs and two past outputs of section.
+             * @return Returns output sample of section.
+             */
+            static T section(const T* c, T input, const T* memory) {
+                return c[0] * input + c[1] * memory[0] + c[2] * memory[1] - c[3] * memory[2] - c[4] * memory[3];
+            }
+
+            /**
+             * @brief Fused kernel filtering block through all sections, used when no crossfade is running.
+             * * Loop over sections is inside loop over samples, so independent work of neighbouring sections overlaps.
+             * * Filter without sections passes samples unchanged.
+             */
+            void run_block(const T* input, T* output, std::size_t length, std::size_t stride_in, std::size_t stride_out) {
+                if (m_memory.empty()) {
+                    for (std::size_t i = 0; i < length; i++, input += stride_in, output += stride_out) {
+                        *output = *input;
+                    }
+                    return;
+                }
+
+                const T* coeff = m_sections.data();
+                const std::size_t count = m_sections.size() / 5;
+                const bool flush = this->get_flush_denormals();
+                T* memory = m_memory.data();
+
+                for (std::size_t i = 0; i < length; i++, input += stride_in, output += stride_out) {
+                    T x = flush ? flush_tiny(*input) : *input;
+                    T* m = memory;
+                    const T* c = coeff;
+                    for (std::size_t s = 0; s < count; s++, m += 2, c += 5) {
+                        T y = c[0] * x + c[1] * m[0] + c[2] * m[1] - c[3] * m[2] - c[4] * m[3];
+                        if (flush) {
+                            y = flush_tiny(y);
+                        }
+                        m[1] = m[0];
+                        m[0] = x;
+                        x = y;
+                    }
+                    m[1] = m[0];
+                    m[0] = x;
+                    *output = x;
+                }
+            }
+
+            /**
+             * @brief Helper multiplying polynomials of all sections.
+             * @param offset Offset of polynomial inside section (0 for b, 3 for a).
+             * @param size Number of stored coeffitients of polynomial.
+             * @param leading_one True if polynomial starts with not stored 1.
+             * @return Returns coeffitients of product.
+             */
+            std::vector<T> expand(std::size_t offset, std::size_t size, bool leading_one) const{
+                std::vector<double> product(1, 1.0);
+                for (std::size_t s = 0; s < get_section_count(); s++) {
+                    double factor[3] = {1.0, 0.0, 0.0};
+                    const T* c = m_sections.data() + 5 * s + offset;
+                    for (std::size_t i = 0; i < size; i++) {
+                        factor[i + (leading_one ? 1 : 0)] = static_cast<double>(c[i]);
+                    }
+
+                    std::vector<double> next(product.size() + 2, 0.0);
+                    for (std::size_t i = 0; i < product.size(); i++) {
+                        for (std::size_t j = 0; j < 3; j++) {
+                            next[i + j] += product[i] * factor[j];
+                        }
+                    }
+                    product.swap(next);
+                }
+                return std::vector<T>(product.begin(), product.end());
+            }
+
+        protected:
+
+            /**
+             * @brief Writes filter memory as binary state (see Base_Filter::save_state()).
+             * @param buffer Pointer to state buffer of at least state_size() bytes.
+             * @return Returns number of written bytes.
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                unsigned char* position = state_put_count(buffer, static_cast<std::uint32_t>(m_memory.size()));
+                position = state_put(position, m_memory.data(), m_memory.size());
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads filter memory from binary state into existing memory (see Base_Filter::load_state()).
+             * @param buffer Pointer to state buffer.
+             * @param size Number of bytes available in buffer.
+             * @return Returns number of read bytes, 0 if state does not match number of sections.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                const unsigned char* end = buffer + size;
+
+                if (!state_get_count(position, end, static_cast<std::uint32_t>(m_memory.size()))
+                    || !state_get(position, end, m_memory.data(), m_memory.size())) {
+                    return 0;
+                }
+
+                return position - buffer;
+            }
+
+        public:
+
+            /**
+             * @brief Deafault constructor of SOS object with one passing section.
+             * * Sets basic values for sampling frequency(44100Hz) and name(SOS).
+             */
+            SOS() : Base_Filter<T>(44100.0, "SOS") {
+                set_coeff(std::vector<T>{1, 0, 0, 0, 0});
+            }
+
+            /**
+             * @brief Parametric constructor for SOS object.
+             * @param sampling_freq Double type sampling frequency of samples to be filtered.
+             * @param filter_name String type name of SOS.
+             * @param sections Vector of sections b0, b1, b2, a1, a2 one after another (numerical type).
+             */
+            SOS(double sampling_freq, std::string filter_name, const std::vector<T>& sections) : Base_Filter<T>(sampling_freq, filter_name) {
+                set_coeff(sections);
+            }
+
+            /**
+             * @brief Parametric constructor for SOS object without sections (to be set later by set_coeff()).
+             * * Until sections are set, filter passes samples unchanged.
+             * @param sampling_freq Double type sampling frequency of samples to be filtered.
+             * @param filter_name String type name of SOS.
+             */
+            SOS(double sampling_freq, std::string filter_name) : Base_Filter<T>(sampling_freq, filter_name) {}
+
+            /**
+            * @brief Virtual destrutor of SOS object.
+            */
+            virtual ~SOS() = default;
+
+            /**
+             * @brief Setter of sections to a SOS filter.
+             * @param sections Vector of sections b0, b1, b2, a1, a2 one after another.
+             * @return Returns true if setting succesful, otherwise false. (size has to be non-zero multiple of 5)
+             */
+            bool set_coeff(const std::vector<T>& sections) {
+                return set_coeff(Shared_Coeff<T>(sections));
+            }
+
+            /**
+             * @brief Setter of shared sections to a SOS filter. Filter keeps reference, coeffitients are not copied.
+             * @param sections Shared sections (for example from Design_Cache).
+             * @return Returns true if setting succesful, otherwise false. (size has to be non-zero multiple of 5)
+             */
+            bool set_coeff(const Shared_Coeff<T>& sections) {
+                if (sections.empty() || sections.size() % 5 != 0) {
+                    return false;
+                }
+
+                m_sections = sections;
+                m_memory = std::vector<T>(2 * (sections.size() / 5) + 2, static_cast<T>(0));
+                m_fade_left = 0;
+                return true;
+            }
+
+            /**
+             * @brief Thread safe request of new sections, to be called from control thread (see IIR::request_coeff()).
+             * @param sections Vector of sections b0, b1, b2, a1, a2 one after another.
+             * @param crossfade Number of samples for interpolation between old and new sections (0 - instant switch). Used only if number of sections is unchanged.
+             * @return Returns true if request was published, otherwise false. (size has to be non-zero multiple of 5)
+             */
+            bool request_coeff(const std::vector<T>& sections, std::size_t crossfade = 0) {
+                return request_coeff(Shared_Coeff<T>(sections), crossfade);
+            }
+
+            /**
+             * @brief Thread safe request of new shared sections, to be called from control thread (see request_coeff()).
+             * @param sections Shared sections.
+             * @param crossfade Number of samples for interpolation between old and new sections (0 - instant switch).
+             * @return Returns true if request was published, otherwise false.
+             */
+            bool request_coeff(const Shared_Coeff<T>& sections, std::size_t crossfade = 0) {
+                if (sections.empty() || sections.size() % 5 != 0) {
+                    return false;
+                }
+
+                Coeff_Slot<T>& slot = m_exchange.back();
+                slot.coeff_b = sections;
+                slot.past_input.assign(2 * (sections.size() / 5) + 2, static_cast<T>(0));
+                slot.crossfade = crossfade;
+                m_exchange.publish();
+
+                return true;
+            }
+
+            /**
+             * @brief Swaps in sections published by request_coeff(). Called by filter_block() at every block boundary.
+             * * Never allocates. Memory is kept when number of sections is unchanged, otherwise memory of first sections is moved.
+             * * Update waits while crossfade of previous update is still running.
+             * @return Returns true if new sections were applied, otherwise false.
+             */
+            bool apply_pending_coeff() {
+                if (m_fade_left > 0 || !m_exchange.fetch()) {
+                    return false;
+                }
+
+                Coeff_Slot<T>& slot = m_exchange.front();
+                std::swap(m_sections, slot.coeff_b);
+
+                if (slot.past_input.size() != m_memory.size()) {
+                    std::size_t keep = std::min(slot.past_input.size(), m_memory.size());
+                    std::copy(m_memory.begin(), m_memory.begin() + keep, slot.past_input.begin());
+                    m_memory.swap(slot.past_input);
+                }
+                else if (slot.crossfade > 0) {
+                    m_fade_length = slot.crossfade;
+                    m_fade_left = slot.crossfade;
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Getter of sections of SOS filter.
+             * @return Returns shared coeffitients b0, b1, b2, a1, a2 of every section (convertible to vector).
+             */
+            const Shared_Coeff<T>& get_sections() const{
+                return m_sections;
+            }
+
+            /**
+             * @brief Getter of number of sections.
+             * @return Returns number of second order sections.
+             */
+            std::size_t get_section_count() const{
+                return m_sections.size() / 5;
+            }
+
+            /**
+             * @brief Coeffitients b of whole filter, product of section numerators (for display and export, high orders lose precision).
+             * @return Returns vector of coeffitients b.
+             */
+            std::vector<T> get_coeff_b() const{
+                return expand(0, 3, false);
+            }
+
+            /**
+             * @brief Coeffitients a of whole filter without a0 = 1 (same layout as IIR::get_coeff_a()).
+             * @return Returns vector of coeffitients a.
+             */
+            std::vector<T> get_coeff_a() const{
+                std::vector<T> a = expand(3, 2, true);
+                a.erase(a.begin());
+                return a;
+            }
+
+            /**
+             * @brief Group delay of filter at given frequency, sum of group delays of sections (see iir_response()).
+             * @param freq Double type frequency in Hz.
+             * @return Returns group delay in samples.
+             */
+            double group_delay(double freq) const override{
+                const double omega = 2.0 * M_PI * freq / this->get_sampling_freq();
+                double delay = 0.0;
+                for (std::size_t s = 0; s < get_section_count(); s++) {
+                    const T* c = m_sections.data() + 5 * s;
+                    delay += iir_response(c, 3, c + 3, 2, omega).delay;
+                }
+                return delay;
+            }
+
+            /**
+             * @brief Latency of filter, group delay averaged over passband (see passband_latency()).
+             * @return Returns latency in samples.
+             */
+            double get_latency() const override{
+                return passband_latency([&](double omega) {
+                    Point_Response result{1.0, 0.0};
+                    for (std::size_t s = 0; s < get_section_count(); s++) {
+                        const T* c = m_sections.data() + 5 * s;
+                        Point_Response point = iir_response(c, 3, c + 3, 2, omega);
+                        result.value *= point.value;
+                        result.delay += point.delay;
+                    }
+                    return result;
+                });
+            }
+
+            /**
+             * @brief Frequency response at arbitrary frequencies, product of section responses (see poly_response_batch()).
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override{
+                std::vector<double> omega(count);
+                std::vector<std::complex<double>> numerator(count), denominator(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    omega[i] = 2.0 * M_PI * freq[i] / this->get_sampling_freq();
+                    response[i] = 1.0;
+                }
+
+                for (std::size_t s = 0; s < get_section_count(); s++) {
+                    const T* c = m_sections.data() + 5 * s;
+                    poly_response_batch(c, 3, omega.data(), numerator.data(), count);
+                    poly_response_batch(c + 3, 2, omega.data(), denominator.data(), count, true);
+                    for (std::size_t i = 0; i < count; i++) {
+                        response[i] *= numerator[i] / denominator[i];
+                    }
+                }
+            }
+
+            /**
+             * @brief Frequency response at n_points evenly spaced frequencies k * fs / (2 n_points) (see poly_response_grid()).
+             * @param n_points Number of frequencies (power of two uses FFT).
+             * @return Returns vector of H values.
+             */
+            std::vector<std::complex<double>> frequency_response(std::size_t n_points) const override{
+                std::vector<std::complex<double>> response(n_points, 1.0);
+                std::vector<std::complex<double>> numerator(n_points), denominator(n_points);
+                for (std::size_t s = 0; s < get_section_count(); s++) {
+                    const T* c = m_sections.data() + 5 * s;
+                    poly_response_grid(c, 3, numerator.data(), n_points);
+                    poly_response_grid(c + 3, 2, denominator.data(), n_points, true);
+                    for (std::size_t k = 0; k < n_points; k++) {
+                        response[k] *= numerator[k] / denominator[k];
+                    }
+                }
+                return response;
+            }
+
+            /**
+             * @brief Getter of filter's memory (two past inputs, then two past outputs of every section).
+             * @return Returns vector of samples in memory.
+             */
+            const std::vector<T>& get_memory() const{
+                return m_memory;
+            }
+
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             * @return Returns number of bytes needed to save filter memory.
+             */
+            std::size_t state_size() const override{
+                return sizeof(std::uint32_t) + m_memory.size() * sizeof(T);
+            }
+
+            /**
+             * @brief Method for reseting filter's internal memory.
+             */
+            void reset() override{
+                std::fill(m_memory.begin(), m_memory.end(), static_cast<T>(0));
+                m_fade_left = 0;
+            }
+
+            /**
+             * @brief Method for filtering a sample of input signal through all sections.
+             * @param input Numerical type input sample.
+             * @return Filtered numerical type input sample (same as input type).
+             */
+            T filter(T input) override{
+                AF_RT_SCOPE();
+                if (m_fade_left == 0) {
+                    T output;
+                    run_block(&input, &output, 1, 1, 1);
+                    return output;
+                }
+
+                // output mix with shared memory equals linear interpolation of coeffitients in every section
+                const T* old = m_exchange.front().coeff_b.data();
+                const T* coeff = m_sections.data();
+                const bool flush = this->get_flush_denormals();
+                T gain = static_cast<T>(m_fade_left) / static_cast<T>(m_fade_length);
+                m_fade_left--;
+
+                T x = flush ? flush_tiny(input) : input;
+                T* m = m_memory.data();
+                for (std::size_t s = 0; s < get_section_count(); s++, m += 2, old += 5, coeff += 5) {
+                    T y = gain * section(old, x, m) + (static_cast<T>(1) - gain) * section(coeff, x, m);
+                    if (flush) {
+                        y = flush_tiny(y);
+                    }
+                    m[1] = m[0];
+                    m[0] = x;
+                    x = y;
+                }
+                m[1] = m[0];
+                m[0] = x;
+                return x;
+            }
+
+            /**
+             * @brief Method for filtering a block of samples by fused kernel. Pending sections are applied before first sample.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                apply_pending_coeff();
+
+                std::size_t i = 0;
+                for (; i < length && m_fade_left > 0; i++) {
+                    output[i] = SOS<T>::filter(input[i]);
+                }
+                run_block(input + i, output + i, length - i, 1, 1);
+            }
+
+            /**
+             * @brief Method for filtering in place one channel of strided buffer. Pending sections are applied before first sample.
+             * @param data Pointer to first sample of the channel.
+             * @param stride Distance between samples of the channel.
+             * @param length Number of samples of the channel.
+             */
+            void filter_block_strided(T* data, std::size_t stride, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                apply_pending_coeff();
+
+                std::size_t i = 0;
+                for (; i < length && m_fade_left > 0; i++, data += stride) {
+                    *data = SOS<T>::filter(*data);
+                }
+                run_block(data, data, length - i, stride, stride);
+            }
+
+            /**
+             * @brief Method for cloning it's self - used to make cascades
+             */
+            std::unique_ptr<Base_Filter<T>> clone() const override {
+                return std::make_unique<SOS<T>>(*this);
+            }
+
+    };
+
 }
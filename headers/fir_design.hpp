@@ -0,0 +1,707 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <complex>
+#include "fft.hpp"
+
+namespace af{
+
+    /**
+     * @brief Highest order tried by minimal order designs (see fir_min_order()), longer specifications are rejected.
+     */
+    const int FIR_MAX_ORDER = 16384;
+
+    /**
+     * @brief Batch calculation of windowed-sinc coeffitients (rectangular window) for many designs of the same order.
+     * * Tap values sin(omega * n) come from recurrence sin(w(n+1)) = 2cos(w)sin(wn) - sin(w(n-1)), so every design costs
+     * * three trigonometric calls instead of one per tap. Only half of symmetric response is calculated.
+     * * Inner loops run across designs (structure of arrays), so compiler can vectorize them.
+     * @tparam T is type of numerical data of coeffitients.
+     * @param order Integer type order of filters (number of taps - 1). Cannot be negative.
+     * @param omega_low Pointer to lower normalized cutoffs (2 pi fc / fs) or nullptr for lowpass/highpass.
+     * @param omega_high Pointer to higher normalized cutoffs (2 pi fc / fs).
+     * @param count Number of designs.
+     * @param stop True for highpass/bandstop (spectral inversion), false for lowpass/bandpass.
+     * @param normalize True if coeffitients of each design should sum to 1 (DC gain of lowpass).
+     * @return Returns vector of coeffitient vectors, one for each design.
+     */
+    template <typename T>
+    std::vector<std::vector<T>> sinc_coeff_batch(int order, const double* omega_low, const double* omega_high, std::size_t count, bool stop, bool normalize){
+        const std::size_t CHUNK = 32;
+        const std::size_t TILE = 64;
+        std::vector<std::vector<T>> result(count);
+
+        if (order < 0) {
+            return result;
+        }
+
+        const std::size_t taps = static_cast<std::size_t>(order) + 1;
+        const std::size_t half = static_cast<std::size_t>(order / 2) + 1;
+        const std::size_t first = taps - half;
+        const double n0 = (order % 2 == 0) ? 0.0 : 0.5;
+        const double sign = stop ? -1.0 : 1.0;
+
+        double tile[TILE * CHUNK];
+        double c_high[CHUNK], s_high[CHUNK], p_high[CHUNK];
+        double c_low[CHUNK], s_low[CHUNK], p_low[CHUNK];
+
+        for (std::size_t base = 0; base < count; base += CHUNK) {
+            const std::size_t width = std::min(CHUNK, count - base);
+
+            for (std::size_t d = 0; d < width; d++) {
+                double w = omega_high[base + d];
+                c_high[d] = 2.0 * std::cos(w);
+                s_high[d] = std::sin(w * n0);
+                p_high[d] = std::sin(w * (n0 - 1.0));
+
+                w = omega_low ? omega_low[base + d] : 0.0;
+                c_low[d] = 2.0 * std::cos(w);
+                s_low[d] = std::sin(w * n0);
+                p_low[d] = std::sin(w * (n0 - 1.0));
+
+                result[base + d].resize(taps);
+            }
+
+            // tiles of TILE taps x width designs stay in L1 cache between recurrence and scatter to coeffitient vectors
+            for (std::size_t k0 = 0; k0 < half; k0 += TILE) {
+                const std::size_t rows = std::min(TILE, half - k0);
+
+                // tile[k][d] = sign * (sin(w_high n) - sin(w_low n)) / (pi n), n = n0 + k0 + k
+                for (std::size_t k = 0; k < rows; k++) {
+                    double n = n0 + static_cast<double>(k0 + k);
+                    double scale = (n == 0.0) ? 0.0 : sign / (M_PI * n);
+                    double* row = &tile[k * width];
+
+                    if (omega_low) {
+                        for (std::size_t d = 0; d < width; d++) {
+                            row[d] = (s_high[d] - s_low[d]) * scale;
+                            double next_high = c_high[d] * s_high[d] - p_high[d];
+                            double next_low = c_low[d] * s_low[d] - p_low[d];
+                            p_high[d] = s_high[d];
+                            p_low[d] = s_low[d];
+                            s_high[d] = next_high;
+                            s_low[d] = next_low;
+                        }
+                    }
+                    else {
+                        for (std::size_t d = 0; d < width; d++) {
+                            row[d] = s_high[d] * scale;
+                            double next_high = c_high[d] * s_high[d] - p_high[d];
+                            p_high[d] = s_high[d];
+                            s_high[d] = next_high;
+                        }
+                    }
+                }
+
+                if (k0 == 0 && n0 == 0.0) {
+                    for (std::size_t d = 0; d < width; d++) {
+                        double band = (omega_high[base + d] - (omega_low ? omega_low[base + d] : 0.0)) / M_PI;
+                        tile[d] = stop ? 1.0 - band : band;
+                    }
+                }
+
+                for (std::size_t d = 0; d < width; d++) {
+                    T* coeff = result[base + d].data();
+
+                    for (std::size_t k = 0; k < rows; k++) {
+                        T value = static_cast<T>(tile[k * width + d]);
+                        coeff[first + k0 + k] = value;
+                        coeff[order - (first + k0 + k)] = value;
+                    }
+                }
+            }
+
+            if (normalize) {
+                for (std::size_t d = 0; d < width; d++) {
+                    std::vector<T>& coeff = result[base + d];
+                    double sum = 0;
+                    for (T val : coeff) {
+                        sum += static_cast<double>(val);
+                    }
+                    if (sum != 0) {
+                        for (T& val : coeff) {
+                            val /= static_cast<T>(sum);
+                        }
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Batch calculation of FIR lowpass coeffitients for many cutoff frequencies (see sinc_coeff_batch()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param order Integer type order of filters.
+     * @param freq_cutoff Vector of cutoff frequencies, one for each design.
+     * @return Returns vector of coeffitient vectors (same as Lowpass::calc_coeff()).
+     */
+    template <typename T>
+    std::vector<std::vector<T>> lowpass_coeff_batch(double sampling_freq, int order, const std::vector<double>& freq_cutoff){
+        std::vector<double> omega(freq_cutoff.size());
+        for (std::size_t d = 0; d < omega.size(); d++) {
+            omega[d] = 2.0 * M_PI * (freq_cutoff[d] / sampling_freq);
+        }
+
+        return sinc_coeff_batch<T>(order, nullptr, omega.data(), omega.size(), false, true);
+    }
+
+    /**
+     * @brief Batch calculation of FIR highpass coeffitients for many cutoff frequencies (see sinc_coeff_batch()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param order Integer type order of filters.
+     * @param freq_cutoff Vector of cutoff frequencies, one for each design.
+     * @return Returns vector of coeffitient vectors (same as Highpass::calc_coeff()).
+     */
+    template <typename T>
+    std::vector<std::vector<T>> highpass_coeff_batch(double sampling_freq, int order, const std::vector<double>& freq_cutoff){
+        std::vector<double> omega(freq_cutoff.size());
+        for (std::size_t d = 0; d < omega.size(); d++) {
+            omega[d] = 2.0 * M_PI * (freq_cutoff[d] / sampling_freq);
+        }
+
+        return sinc_coeff_batch<T>(order, nullptr, omega.data(), omega.size(), true, false);
+    }
+
+    /**
+     * @brief Batch calculation of FIR bandpass coeffitients for many pairs of cutoff frequencies (see sinc_coeff_batch()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param order Integer type order of filters.
+     * @param freq_cut_low Vector of lower cutoff frequencies.
+     * @param freq_cut_high Vector of higher cutoff frequencies (same size as lower).
+     * @return Returns vector of coeffitient vectors (same as Bandpass::calc_coeff()). Empty if sizes differ.
+     */
+    template <typename T>
+    std::vector<std::vector<T>> bandpass_coeff_batch(double sampling_freq, int order, const std::vector<double>& freq_cut_low, const std::vector<double>& freq_cut_high){
+        if (freq_cut_low.size() != freq_cut_high.size()) {
+            return {};
+        }
+
+        std::vector<double> omega_1(freq_cut_low.size());
+        std::vector<double> omega_2(freq_cut_high.size());
+        for (std::size_t d = 0; d < omega_1.size(); d++) {
+            omega_1[d] = 2.0 * M_PI * (freq_cut_low[d] / sampling_freq);
+            omega_2[d] = 2.0 * M_PI * (freq_cut_high[d] / sampling_freq);
+        }
+
+        return sinc_coeff_batch<T>(order, omega_1.data(), omega_2.data(), omega_1.size(), false, false);
+    }
+
+    /**
+     * @brief Batch calculation of FIR bandstop coeffitients for many pairs of cutoff frequencies (see sinc_coeff_batch()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param order Integer type order of filters.
+     * @param freq_cut_low Vector of lower cutoff frequencies.
+     * @param freq_cut_high Vector of higher cutoff frequencies (same size as lower).
+     * @return Returns vector of coeffitient vectors (same as Bandstop::calc_coeff()). Empty if sizes differ.
+     */
+    template <typename T>
+    std::vector<std::vector<T>> bandstop_coeff_batch(double sampling_freq, int order, const std::vector<double>& freq_cut_low, const std::vector<double>& freq_cut_high){
+        if (freq_cut_low.size() != freq_cut_high.size()) {
+            return {};
+        }
+
+        std::vector<double> omega_1(freq_cut_low.size());
+        std::vector<double> omega_2(freq_cut_high.size());
+        for (std::size_t d = 0; d < omega_1.size(); d++) {
+            omega_1[d] = 2.0 * M_PI * (freq_cut_low[d] / sampling_freq);
+            omega_2[d] = 2.0 * M_PI * (freq_cut_high[d] / sampling_freq);
+        }
+
+        return sinc_coeff_batch<T>(order, omega_1.data(), omega_2.data(), omega_1.size(), true, false);
+    }
+
+    /**
+     * @brief Specification of FIR lowpass/highpass response for design with automatic order (see kaiser_lowpass_coeff()).
+     * * Lowpass has freq_pass < freq_stop, highpass has freq_stop < freq_pass.
+     */
+    struct FIR_Spec {
+        double freq_pass;
+        double freq_stop;
+        double pass_ripple;     // peak-to-peak passband ripple in dB
+        double stop_atten;      // minimal stopband attenuation in dB
+    };
+
+    /**
+     * @brief Specification of FIR bandpass/bandstop response for design with automatic order (see kaiser_bandpass_coeff()).
+     * * Bandpass has freq_stop_low < freq_pass_low < freq_pass_high < freq_stop_high,
+     * * bandstop has freq_pass_low < freq_stop_low < freq_stop_high < freq_pass_high.
+     */
+    struct FIR_Band_Spec {
+        double freq_pass_low;
+        double freq_pass_high;
+        double freq_stop_low;
+        double freq_stop_high;
+        double pass_ripple;     // peak-to-peak passband ripple in dB
+        double stop_atten;      // minimal stopband attenuation in dB
+    };
+
+    /**
+     * @brief Order and window shape estimated by kaiser_estimate().
+     */
+    struct Kaiser_Params {
+        int order;
+        double beta;
+    };
+
+    /**
+     * @brief Modified Bessel function of the first kind and order zero (power series).
+     */
+    inline double bessel_i0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        const double half_square = 0.25 * x * x;
+
+        for (int k = 1; k < 200; k++) {
+            term *= half_square / (static_cast<double>(k) * static_cast<double>(k));
+            sum += term;
+            if (term < sum * 1e-17) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Estimates order and beta of Kaiser window meeting given ripple and attenuation (Kaiser's formulas).
+     * * Windowed design has the same deviation in pass and stop band, so the smaller of both deviations is used.
+     * @param sampling_freq Double type sampling frequency.
+     * @param transition Width of the narrowest transition band in Hz.
+     * @param pass_ripple Peak-to-peak passband ripple in dB.
+     * @param stop_atten Minimal stopband attenuation in dB.
+     * @return Returns estimated order (0 if transition is not positive, at most FIR_MAX_ORDER + 1) and beta of window.
+     */
+    inline Kaiser_Params kaiser_estimate(double sampling_freq, double transition, double pass_ripple, double stop_atten) {
+        double gain = std::pow(10.0, pass_ripple / 20.0);
+        double delta = std::min((gain - 1.0) / (gain + 1.0), std::pow(10.0, -stop_atten / 20.0));
+        double atten = -20.0 * std::log10(delta);
+
+        Kaiser_Params params{0, 0.0};
+        if (atten > 50.0) {
+            params.beta = 0.1102 * (atten - 8.7);
+        }
+        else if (atten >= 21.0) {
+            params.beta = 0.5842 * std::pow(atten - 21.0, 0.4) + 0.07886 * (atten - 21.0);
+        }
+
+        double omega = 2.0 * M_PI * transition / sampling_freq;
+        if (omega > 0.0) {
+            params.order = static_cast<int>(std::ceil(std::min(std::max(atten - 8.0, 0.0) / (2.285 * omega), FIR_MAX_ORDER + 1.0)));
+        }
+        return params;
+    }
+
+    /**
+     * @brief Multiplies coeffitients by Kaiser window of given beta (in place).
+     * @param coeff Coeffitients of filter.
+     * @param beta Shape of window, 0 is rectangular window.
+     */
+    template <typename T>
+    void kaiser_window(std::vector<T>& coeff, double beta) {
+        if (coeff.size() < 2) {
+            return;
+        }
+
+        const double center = 0.5 * static_cast<double>(coeff.size() - 1);
+        const double norm = 1.0 / bessel_i0(beta);
+        for (std::size_t n = 0; n < coeff.size(); n++) {
+            double x = (static_cast<double>(n) - center) / center;
+            coeff[n] = static_cast<T>(static_cast<double>(coeff[n]) * bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - x * x))) * norm);
+        }
+    }
+
+    /**
+     * @brief Magnitude of FIR frequency response at one normalized frequency.
+     * @param coeff Coeffitients of filter.
+     * @param omega Normalized frequency (2 pi f / fs).
+     * @return Returns |H(e^jw)|.
+     */
+    template <typename T>
+    double fir_magnitude(const std::vector<T>& coeff, double omega) {
+        const double step_re = std::cos(omega);
+        const double step_im = -std::sin(omega);
+        double re = 0.0, im = 0.0;
+        double rot_re = 1.0, rot_im = 0.0;
+
+        for (T value : coeff) {
+            re += static_cast<double>(value) * rot_re;
+            im += static_cast<double>(value) * rot_im;
+            double next = rot_re * step_re - rot_im * step_im;
+            rot_im = rot_re * step_im + rot_im * step_re;
+            rot_re = next;
+        }
+        return std::sqrt(re * re + im * im);
+    }
+
+    /**
+     * @brief Group delay of FIR filter at one normalized frequency, tau = Re(sum n h[n] z^-n / sum h[n] z^-n).
+     * @param coeff Coeffitients of filter.
+     * @param omega Normalized frequency (2 pi f / fs).
+     * @return Returns group delay in samples (0 at zeros of response).
+     */
+    template <typename T>
+    double fir_group_delay(const std::vector<T>& coeff, double omega) {
+        const double step_re = std::cos(omega);
+        const double step_im = -std::sin(omega);
+        double re = 0.0, im = 0.0, ramp_re = 0.0, ramp_im = 0.0;
+        double rot_re = 1.0, rot_im = 0.0;
+
+        for (std::size_t n = 0; n < coeff.size(); n++) {
+            double value = static_cast<double>(coeff[n]);
+            re += value * rot_re;
+            im += value * rot_im;
+            ramp_re += static_cast<double>(n) * value * rot_re;
+            ramp_im += static_cast<double>(n) * value * rot_im;
+            double next = rot_re * step_re - rot_im * step_im;
+            rot_im = rot_re * step_im + rot_im * step_re;
+            rot_re = next;
+        }
+
+        double power = re * re + im * im;
+        return power > 0.0 ? (ramp_re * re + ramp_im * im) / power : 0.0;
+    }
+
+    /**
+     * @brief Pass or stop band of specification checked by fir_meets_spec(), frequencies in Hz.
+     */
+    struct FIR_Spec_Band {
+        double freq_begin;
+        double freq_end;
+        bool pass;
+    };
+
+    /**
+     * @brief Checks FIR response against specification on FFT grid (16 points per tap from 0 to sampling_freq, at least 1024)
+     * * and at band edges. Costs one FFT instead of evaluating every grid point separately.
+     * @param coeff Coeffitients of filter.
+     * @param sampling_freq Double type sampling frequency.
+     * @param bands Pass and stop bands of specification.
+     * @param delta_pass Allowed deviation of magnitude from 1 in pass bands.
+     * @param delta_stop Allowed magnitude in stop bands.
+     * @return Returns true if every band is within its tolerance.
+     */
+    template <typename T>
+    bool fir_meets_spec(const std::vector<T>& coeff, double sampling_freq, const std::vector<FIR_Spec_Band>& bands, double delta_pass, double delta_stop) {
+        std::vector<std::complex<double>> spectrum(fft_size(std::max<std::size_t>(1024, 16 * coeff.size())));
+        for (std::size_t n = 0; n < coeff.size(); n++) {
+            spectrum[n] = static_cast<double>(coeff[n]);
+        }
+        fft(spectrum);
+
+        const double bin = sampling_freq / static_cast<double>(spectrum.size());
+        const std::size_t last_bin = spectrum.size() / 2;
+        for (const FIR_Spec_Band& band : bands) {
+            auto within = [&](double magnitude) {
+                return band.pass ? std::fabs(magnitude - 1.0) <= delta_pass : magnitude <= delta_stop;
+            };
+
+            if (!within(fir_magnitude(coeff, 2.0 * M_PI * band.freq_begin / sampling_freq))
+                || !within(fir_magnitude(coeff, 2.0 * M_PI * band.freq_end / sampling_freq))) {
+                return false;
+            }
+
+            const std::size_t first = static_cast<std::size_t>(std::max(0.0, std::ceil(band.freq_begin / bin)));
+            const std::size_t last = std::min(last_bin, static_cast<std::size_t>(std::max(0.0, std::floor(band.freq_end / bin))));
+            for (std::size_t k = first; k <= last; k++) {
+                if (!within(std::abs(spectrum[k]))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Searches smallest order for which designed filter meets the specification, starting at estimated order.
+     * * Order is moved away from estimate in jumps until result of check changes, then the last interval is searched,
+     * * so only a few designs are made even if estimate is off by a lot. Equiripple designs are monotonic in order, jumps
+     * * double and interval is bisected. Windowed designs meet the specification in narrow windows of orders, so jumps stay
+     * * about 1 % of estimate and interval is scanned one candidate at a time (result is first meeting order of interval).
+     * @param estimate Starting order, candidates are estimate plus multiples of step.
+     * @param step 1, 2 if order has to be even, 4 for halfband (order 2 modulo 4).
+     * @param max_order Highest tried order (at most FIR_MAX_ORDER).
+     * @param design Function returning coeffitients for given order.
+     * @param meets Function checking coeffitients against the specification.
+     * @param windowed True for windowed designs (bounded jumps and local scan), false for equiripple designs.
+     * @return Returns coeffitients of smallest found order meeting the specification, empty if no order up to max_order meets it.
+     */
+    template <typename T, typename Design, typename Check>
+    std::vector<T> fir_min_order(int estimate, int step, int max_order, Design design, Check meets, bool windowed = false) {
+        max_order = std::min(max_order, FIR_MAX_ORDER);
+        int pass = std::max(estimate, step);
+        if (pass > max_order) {
+            return {};
+        }
+
+        const int lowest = pass % step == 0 ? step : pass % step;
+        const int growth = windowed ? 1 : 2;
+        int fail = lowest - step;
+        int jump = std::max(step, pass / (windowed ? 128 : 16) / step * step);
+        std::vector<T> best = design(pass);
+
+        if (meets(best)) {
+            while (pass - jump >= lowest) {
+                std::vector<T> coeff = design(pass - jump);
+                if (!meets(coeff)) {
+                    fail = pass - jump;
+                    break;
+                }
+                best = std::move(coeff);
+                pass -= jump;
+                jump *= growth;
+            }
+        }
+        else {
+            fail = pass;
+            while (true) {
+                if (fail + step > max_order) {
+                    return {};
+                }
+                int order = fail + std::min(jump, (max_order - fail) / step * step);
+                std::vector<T> coeff = design(order);
+                if (meets(coeff)) {
+                    best = std::move(coeff);
+                    pass = order;
+                    break;
+                }
+                fail = order;
+                jump *= growth;
+            }
+        }
+
+        if (windowed) {
+            for (int order = fail + step; order < pass; order += step) {
+                std::vector<T> coeff = design(order);
+                if (meets(coeff)) {
+                    return coeff;
+                }
+            }
+            return best;
+        }
+
+        while (pass - fail > step) {
+            int order = fail + (pass - fail) / 2 / step * step;
+            std::vector<T> coeff = design(order);
+            if (meets(coeff)) {
+                best = std::move(coeff);
+                pass = order;
+            }
+            else {
+                fail = order;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief Kaiser windowed-sinc design with minimal order meeting the specification.
+     * * Order from kaiser_estimate() is corrected by fir_min_order() with fir_meets_spec() check, in bounded jumps and
+     * * local scan (formula alone is off by a few percent of taps).
+     * @param sampling_freq Double type sampling frequency.
+     * @param freq_cut_low Lower cutoff (middle of transition band) or 0 for lowpass/highpass.
+     * @param freq_cut_high Higher cutoff (middle of transition band).
+     * @param stop True for highpass/bandstop (spectral inversion, order is kept even).
+     * @param transition Width of the narrowest transition band in Hz.
+     * @param pass_ripple Peak-to-peak passband ripple in dB.
+     * @param stop_atten Minimal stopband attenuation in dB.
+     * @param bands Pass and stop bands checked against the specification.
+     * @return Returns coeffitients (order is size - 1). Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> kaiser_design_coeff(double sampling_freq, double freq_cut_low, double freq_cut_high, bool stop, double transition,
+                                       double pass_ripple, double stop_atten, const std::vector<FIR_Spec_Band>& bands) {
+        if (sampling_freq <= 0.0 || transition <= 0.0 || pass_ripple <= 0.0 || stop_atten <= 0.0) {
+            return {};
+        }
+
+        const double gain = std::pow(10.0, pass_ripple / 20.0);
+        const double delta_pass = (gain - 1.0) / (gain + 1.0);
+        const double delta_stop = std::pow(10.0, -stop_atten / 20.0);
+        const double omega_low = 2.0 * M_PI * freq_cut_low / sampling_freq;
+        const double omega_high = 2.0 * M_PI * freq_cut_high / sampling_freq;
+        const Kaiser_Params params = kaiser_estimate(sampling_freq, transition, pass_ripple, stop_atten);
+        const int step = stop ? 2 : 1;
+
+        auto design = [&](int order) {
+            std::vector<T> coeff = std::move(sinc_coeff_batch<T>(order, freq_cut_low > 0.0 ? &omega_low : nullptr, &omega_high, 1, stop, false)[0]);
+            kaiser_window(coeff, params.beta);
+            if (freq_cut_low <= 0.0 && !stop) {
+                double sum = 0.0;
+                for (T value : coeff) {
+                    sum += static_cast<double>(value);
+                }
+                for (T& value : coeff) {
+                    value = static_cast<T>(static_cast<double>(value) / sum);
+                }
+            }
+            return coeff;
+        };
+
+        auto meets = [&](const std::vector<T>& coeff) {
+            return fir_meets_spec(coeff, sampling_freq, bands, delta_pass, delta_stop);
+        };
+
+        int order = std::max(params.order, step);
+        order += order % step;
+        return fir_min_order<T>(order, step, 2 * order + 64, design, meets, true);
+    }
+
+    /**
+     * @brief Kaiser window FIR lowpass with minimal order meeting the specification (see kaiser_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, freq_pass < freq_stop < sampling_freq / 2.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    std::vector<T> kaiser_lowpass_coeff(double sampling_freq, const FIR_Spec& spec) {
+        if (spec.freq_pass <= 0.0 || spec.freq_stop <= spec.freq_pass || 2.0 * spec.freq_stop >= sampling_freq) {
+            return {};
+        }
+
+        return kaiser_design_coeff<T>(sampling_freq, 0.0, 0.5 * (spec.freq_pass + spec.freq_stop), false, spec.freq_stop - spec.freq_pass,
+                                      spec.pass_ripple, spec.stop_atten, {{0.0, spec.freq_pass, true}, {spec.freq_stop, 0.5 * sampling_freq, false}});
+    }
+
+    /**
+     * @brief Kaiser window FIR highpass with minimal (even) order meeting the specification (see kaiser_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, freq_stop < freq_pass < sampling_freq / 2.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    std::vector<T> kaiser_highpass_coeff(double sampling_freq, const FIR_Spec& spec) {
+        if (spec.freq_stop <= 0.0 || spec.freq_pass <= spec.freq_stop || 2.0 * spec.freq_pass >= sampling_freq) {
+            return {};
+        }
+
+        return kaiser_design_coeff<T>(sampling_freq, 0.0, 0.5 * (spec.freq_pass + spec.freq_stop), true, spec.freq_pass - spec.freq_stop,
+                                      spec.pass_ripple, spec.stop_atten, {{0.0, spec.freq_stop, false}, {spec.freq_pass, 0.5 * sampling_freq, true}});
+    }
+
+    /**
+     * @brief Kaiser window FIR bandpass with minimal order meeting the specification (see kaiser_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, see FIR_Band_Spec.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    std::vector<T> kaiser_bandpass_coeff(double sampling_freq, const FIR_Band_Spec& spec) {
+        if (spec.freq_stop_low <= 0.0 || spec.freq_pass_low <= spec.freq_stop_low || spec.freq_pass_high <= spec.freq_pass_low
+            || spec.freq_stop_high <= spec.freq_pass_high || 2.0 * spec.freq_stop_high >= sampling_freq) {
+            return {};
+        }
+
+        return kaiser_design_coeff<T>(sampling_freq, 0.5 * (spec.freq_stop_low + spec.freq_pass_low), 0.5 * (spec.freq_pass_high + spec.freq_stop_high), false,
+                                      std::min(spec.freq_pass_low - spec.freq_stop_low, spec.freq_stop_high - spec.freq_pass_high), spec.pass_ripple, spec.stop_atten,
+                                      {{0.0, spec.freq_stop_low, false}, {spec.freq_pass_low, spec.freq_pass_high, true}, {spec.freq_stop_high, 0.5 * sampling_freq, false}});
+    }
+
+    /**
+     * @brief Kaiser window FIR bandstop with minimal (even) order meeting the specification (see kaiser_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, see FIR_Band_Spec.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    std::vector<T> kaiser_bandstop_coeff(double sampling_freq, const FIR_Band_Spec& spec) {
+        if (spec.freq_pass_low <= 0.0 || spec.freq_stop_low <= spec.freq_pass_low || spec.freq_stop_high <= spec.freq_stop_low
+            || spec.freq_pass_high <= spec.freq_stop_high || 2.0 * spec.freq_pass_high >= sampling_freq) {
+            return {};
+        }
+
+        return kaiser_design_coeff<T>(sampling_freq, 0.5 * (spec.freq_pass_low + spec.freq_stop_low), 0.5 * (spec.freq_stop_high + spec.freq_pass_high), true,
+                                      std::min(spec.freq_stop_low - spec.freq_pass_low, spec.freq_pass_high - spec.freq_stop_high), spec.pass_ripple, spec.stop_atten,
+                                      {{0.0, spec.freq_pass_low, true}, {spec.freq_stop_low, spec.freq_stop_high, false}, {spec.freq_pass_high, 0.5 * sampling_freq, true}});
+    }
+
+
+    /**
+     * @brief Kaiser window halfband lowpass with minimal order (cutoff fs / 4, see kaiser_design_coeff()).
+     * * Order is 2 modulo 4, so every tap at even distance from center is exactly 0 (except center tap 0.5) and both end taps
+     * * are nonzero. Zero skipping FIR kernel multiplies only about half of taps per sample (see FIR::get_tap_layout()).
+     * * Response is symmetric around fs / 4, H(f) + H(fs / 2 - f) = 1, so passband deviation equals stopband deviation.
+     * @param sampling_freq Double type sampling frequency.
+     * @param transition Width of transition band centered at sampling_freq / 4 in Hz.
+     * @param stop_atten Minimal stopband attenuation in dB (passband deviation is the same).
+     * @return Returns coeffitients (order is size - 1). Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> halfband_coeff(double sampling_freq, double transition, double stop_atten) {
+        if (sampling_freq <= 0.0 || transition <= 0.0 || transition >= 0.5 * sampling_freq || stop_atten <= 0.0) {
+            return {};
+        }
+
+        const double delta = std::pow(10.0, -stop_atten / 20.0);
+        const Kaiser_Params params = kaiser_estimate(sampling_freq, transition, 20.0 * std::log10((1.0 + delta) / (1.0 - delta)), stop_atten);
+        const std::vector<FIR_Spec_Band> bands = {{0.0, 0.25 * sampling_freq - 0.5 * transition, true},
+                                                  {0.25 * sampling_freq + 0.5 * transition, 0.5 * sampling_freq, false}};
+
+        auto design = [&](int order) {
+            const int half = order / 2;
+            std::vector<double> coeff(static_cast<std::size_t>(order) + 1, 0.0);
+            for (int n = 1; n <= half; n += 2) {
+                double value = ((n / 2) % 2 == 0 ? 1.0 : -1.0) / (M_PI * static_cast<double>(n));
+                coeff[static_cast<std::size_t>(half + n)] = value;
+                coeff[static_cast<std::size_t>(half - n)] = value;
+            }
+            kaiser_window(coeff, params.beta);
+
+            // odd taps sum to 1 / 2 (DC gain 1), even taps stay exactly 0
+            double sum = 0.0;
+            for (int n = 1; n <= half; n += 2) {
+                sum += 2.0 * coeff[static_cast<std::size_t>(half + n)];
+            }
+            std::vector<T> result(coeff.size(), static_cast<T>(0));
+            for (int n = 1; n <= half; n += 2) {
+                result[static_cast<std::size_t>(half + n)] = static_cast<T>(0.5 * coeff[static_cast<std::size_t>(half + n)] / sum);
+                result[static_cast<std::size_t>(half - n)] = result[static_cast<std::size_t>(half + n)];
+            }
+            result[static_cast<std::size_t>(half)] = static_cast<T>(0.5);
+            return result;
+        };
+
+        auto meets = [&](const std::vector<T>& coeff) {
+            return fir_meets_spec(coeff, sampling_freq, bands, delta, delta);
+        };
+
+        int order = std::max(params.order, 2);
+        order += (6 - order % 4) % 4;
+        return fir_min_order<T>(order, 4, 2 * order + 64, design, meets, true);
+    }
+
+    /**
+     * @brief Kaiser window Hilbert transformer (90 degree phase shifter) with minimal order, built from halfband_coeff().
+     * * Taps are halfband taps modulated by 2 sin(pi n / 2), so every other tap is exactly 0 (antisymmetric, order 2 modulo 4).
+     * * Output is Hilbert transform of input delayed by order / 2 samples, magnitude is 1 between transition and
+     * * sampling_freq / 2 - transition.
+     * @param sampling_freq Double type sampling frequency.
+     * @param transition Width of transition bands at 0 Hz and at sampling_freq / 2 in Hz.
+     * @param atten Maximal deviation of magnitude from 1 in the band, in dB below 1 (for example 60 for deviation 0.001).
+     * @return Returns coeffitients (order is size - 1). Empty if specification is invalid or cannot be met.
+     */
+    template <typename T>
+    std::vector<T> hilbert_coeff(double sampling_freq, double transition, double atten) {
+        if (transition >= 0.25 * sampling_freq) {
+            return {};
+        }
+
+        // deviation of Hilbert transformer is twice the deviation of halfband with doubled transition
+        std::vector<T> coeff = halfband_coeff<T>(sampling_freq, 2.0 * transition, atten + 20.0 * std::log10(2.0));
+        const std::size_t half = coeff.size() / 2;
+        for (std::size_t n = 1; n <= half && !coeff.empty(); n++) {
+            const T sign = static_cast<T>((n / 2) % 2 == 0 ? 2.0 : -2.0);
+            coeff[half + n] = (n % 2 == 1) ? sign * coeff[half + n] : static_cast<T>(0);
+            coeff[half - n] = -coeff[half + n];
+        }
+        if (!coeff.empty()) {
+            coeff[half] = static_cast<T>(0);
+        }
+        return coeff;
+    }
+
+}
@@ -0,0 +1,591 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <algorithm>
+
+namespace af{
+
+    /**
+     * @brief Analog prototypes of IIR designs (see iir_sos_coeff()).
+     */
+    enum class IIR_Prototype { Butterworth, Chebyshev1, Chebyshev2 };
+
+    /**
+     * @brief Zeros, poles and gain of transfer function. Gain is magnitude at reference frequency
+     * * (DC for lowpass, Nyquist for highpass), so it does not depend on the frequency transformation.
+     */
+    struct Pole_Zero {
+        std::vector<std::complex<double>> zeros;
+        std::vector<std::complex<double>> poles;
+        double gain = 1.0;
+    };
+
+    /**
+     * @brief Analog lowpass prototype of given order with cutoff 1 rad/s (stopband edge for Chebyshev2).
+     * * Poles of Chebyshev designs lie on ellipse, angles (2k + 1) pi / 2N are the same as for Butterworth.
+     * @param prototype Type of prototype.
+     * @param order Integer type order of filter.
+     * @param ripple Passband ripple in dB (Chebyshev1) or stopband attenuation in dB (Chebyshev2), unused for Butterworth.
+     * @return Returns zeros, poles and gain, empty if order or ripple is not valid.
+     */
+    inline Pole_Zero analog_prototype(IIR_Prototype prototype, int order, double ripple) {
+        Pole_Zero result;
+        if (order < 1 || (prototype != IIR_Prototype::Butterworth && !(ripple > 0.0))) {
+            return result;
+        }
+
+        double epsilon = 1.0;
+        if (prototype == IIR_Prototype::Chebyshev1) {
+            epsilon = std::sqrt(std::pow(10.0, ripple / 10.0) - 1.0);
+            if (order % 2 == 0) {
+                result.gain = 1.0 / std::sqrt(1.0 + epsilon * epsilon);
+            }
+        }
+        else if (prototype == IIR_Prototype::Chebyshev2) {
+            epsilon = 1.0 / std::sqrt(std::pow(10.0, ripple / 10.0) - 1.0);
+        }
+        const double mu = std::asinh(1.0 / epsilon) / order;
+
+        for (int k = 0; k < order; k++) {
+            const double theta = M_PI * (2.0 * k + 1.0) / (2.0 * order);
+            if (prototype == IIR_Prototype::Butterworth) {
+                result.poles.emplace_back(-std::sin(theta), std::cos(theta));
+                continue;
+            }
+
+            std::complex<double> pole(-std::sinh(mu) * std::sin(theta), std::cosh(mu) * std::cos(theta));
+            if (prototype == IIR_Prototype::Chebyshev2) {
+                // inverse Chebyshev: poles and zeros are reciprocal of Chebyshev1 ones
+                pole = 1.0 / pole;
+                if (std::fabs(std::cos(theta)) > 1e-12) {
+                    result.zeros.emplace_back(0.0, 1.0 / std::cos(theta));
+                }
+            }
+            result.poles.push_back(pole);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Transforms analog lowpass prototype to digital lowpass or highpass by bilinear transform with prewarping.
+     * * Zeros at infinity of prototype end at z = -1 (lowpass) or z = 1 (highpass).
+     * @param analog Prototype from analog_prototype().
+     * @param sampling_freq Double type sampling frequency.
+     * @param freq_cutoff Double type cutoff frequency (between 0 and sampling_freq / 2).
+     * @param highpass True for highpass transformation s -> 1 / s.
+     * @return Returns digital zeros, poles and gain.
+     */
+    inline Pole_Zero bilinear_zpk(const Pole_Zero& analog, double sampling_freq, double freq_cutoff, bool highpass) {
+        const double k = std::tan(M_PI * freq_cutoff / sampling_freq);
+        auto to_digital = [&](std::complex<double> s) {
+            s = highpass ? k / s : k * s;
+            return (1.0 + s) / (1.0 - s);
+        };
+
+        Pole_Zero result;
+        result.gain = analog.gain;
+        for (const std::complex<double>& pole : analog.poles) {
+            result.poles.push_back(to_digital(pole));
+        }
+        for (const std::complex<double>& zero : analog.zeros) {
+            result.zeros.push_back(to_digital(zero));
+        }
+        result.zeros.resize(result.poles.size(), std::complex<double>(highpass ? 1.0 : -1.0));
+
+        return result;
+    }
+
+    /**
+     * @brief Groups digital zeros and poles into second order sections.
+     * * Poles closest to the unit circle are paired first with their nearest zeros (so zeros damp resonance of the same
+     * * section), sections are then ordered by growing pole radius, so the most resonant section is last and does not
+     * * drive the others. Every section has unity magnitude at reference frequency, gain of design is put in first section.
+     * * Odd order gives one first order section (b2 = a2 = 0).
+     * @param design Digital zeros, poles (conjugate pairs) and gain, same number of zeros and poles.
+     * @param reference Normalized reference frequency (0 for lowpass, pi for highpass, center for bandpass).
+     * @return Returns sections b0, b1, b2, a1, a2 one after another (a0 = 1 is not stored).
+     */
+    inline std::vector<double> zpk_to_sos(const Pole_Zero& design, double reference) {
+        struct Section {
+            std::complex<double> pole[2];
+            std::complex<double> zero[2];
+            int size;
+        };
+
+        auto is_real = [](const std::complex<double>& value) {
+            return std::fabs(value.imag()) <= 1e-10 * std::max(1.0, std::abs(value));
+        };
+        auto by_radius = [](const std::complex<double>& x, const std::complex<double>& y) {
+            return std::abs(x) > std::abs(y);
+        };
+
+        // roots in upper half plane stand for conjugate pairs, roots in lower half plane are skipped
+        std::vector<std::complex<double>> complex_zeros, real_zeros, complex_poles, real_poles;
+        for (const std::complex<double>& zero : design.zeros) {
+            if (is_real(zero)) {
+                real_zeros.emplace_back(zero.real(), 0.0);
+            }
+            else if (zero.imag() > 0.0) {
+                complex_zeros.push_back(zero);
+            }
+        }
+        for (const std::complex<double>& pole : design.poles) {
+            if (is_real(pole)) {
+                real_poles.emplace_back(pole.real(), 0.0);
+            }
+            else if (pole.imag() > 0.0) {
+                complex_poles.push_back(pole);
+            }
+        }
+        std::sort(real_poles.begin(), real_poles.end(), by_radius);
+
+        std::vector<Section> sections;
+        for (const std::complex<double>& pole : complex_poles) {
+            sections.push_back({{pole, std::conj(pole)}, {}, 2});
+        }
+        for (std::size_t i = 0; i + 1 < real_poles.size(); i += 2) {
+            sections.push_back({{real_poles[i], real_poles[i + 1]}, {}, 2});
+        }
+        if (real_poles.size() % 2 == 1) {
+            sections.push_back({{real_poles.back(), 0.0}, {}, 1});
+        }
+
+        auto take_nearest = [](std::vector<std::complex<double>>& pool, const std::complex<double>& target) {
+            auto nearest = std::min_element(pool.begin(), pool.end(), [&](const std::complex<double>& x, const std::complex<double>& y) {
+                return std::abs(x - target) < std::abs(y - target);
+            });
+            std::complex<double> value = *nearest;
+            pool.erase(nearest);
+            return value;
+        };
+
+        // first order section needs real zero, the rest is paired from the most resonant section
+        std::stable_sort(sections.begin(), sections.end(), [](const Section& x, const Section& y) {
+            return x.size < y.size || (x.size == y.size && std::abs(x.pole[0]) > std::abs(y.pole[0]));
+        });
+        for (Section& section : sections) {
+            if (section.size == 1) {
+                section.zero[0] = real_zeros.empty() ? std::complex<double>(0.0) : take_nearest(real_zeros, section.pole[0]);
+                continue;
+            }
+
+            const std::complex<double> target = section.pole[0];
+            bool use_complex = !complex_zeros.empty();
+            if (use_complex && real_zeros.size() >= 2) {
+                auto distance = [&](const std::vector<std::complex<double>>& pool) {
+                    double best = HUGE_VAL;
+                    for (const std::complex<double>& value : pool) {
+                        best = std::min(best, std::abs(value - target));
+                    }
+                    return best;
+                };
+                use_complex = distance(complex_zeros) <= distance(real_zeros);
+            }
+
+            if (use_complex) {
+                section.zero[0] = take_nearest(complex_zeros, target);
+                section.zero[1] = std::conj(section.zero[0]);
+            }
+            else if (real_zeros.size() >= 2) {
+                section.zero[0] = take_nearest(real_zeros, target);
+                section.zero[1] = take_nearest(real_zeros, target);
+            }
+        }
+
+        std::stable_sort(sections.begin(), sections.end(), [](const Section& x, const Section& y) {
+            return std::abs(x.pole[0]) < std::abs(y.pole[0]);
+        });
+
+        const std::complex<double> delay(std::cos(reference), -std::sin(reference));
+        std::vector<double> result;
+        result.reserve(5 * sections.size());
+        for (std::size_t i = 0; i < sections.size(); i++) {
+            const Section& section = sections[i];
+            double b[3] = {1.0, -(section.zero[0] + section.zero[1]).real(), (section.zero[0] * section.zero[1]).real()};
+            double a[2] = {-(section.pole[0] + section.pole[1]).real(), (section.pole[0] * section.pole[1]).real()};
+
+            double gain = std::abs(1.0 + (a[0] + a[1] * delay) * delay) / std::abs(b[0] + (b[1] + b[2] * delay) * delay);
+            if (i == 0) {
+                gain *= design.gain;
+            }
+            result.insert(result.end(), {b[0] * gain, b[1] * gain, b[2] * gain, a[0], a[1]});
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Calculates Nth order IIR lowpass or highpass as second order sections (see zpk_to_sos()).
+     * * Design goes from analog prototype through bilinear transform, polynomial of whole filter is never formed,
+     * * so high orders keep their precision.
+     * @param prototype Butterworth, Chebyshev1 or Chebyshev2.
+     * @param sampling_freq Double type sampling frequency.
+     * @param order Integer type order of filter.
+     * @param freq_cutoff Double type cutoff frequency (-3 dB for Butterworth, end of passband ripple for Chebyshev1,
+     * * start of stopband for Chebyshev2), has to be between 0 and sampling_freq / 2.
+     * @param ripple Passband ripple in dB (Chebyshev1) or stopband attenuation in dB (Chebyshev2).
+     * @param highpass True for highpass.
+     * @return Returns sections b0, b1, b2, a1, a2 one after another, empty if order, cutoff or ripple is not valid.
+     */
+    template <typename T>
+    std::vector<T> iir_sos_coeff(IIR_Prototype prototype, double sampling_freq, int order, double freq_cutoff, double ripple, bool highpass) {
+        if (!(sampling_freq > 0.0) || !(freq_cutoff > 0.0) || !(2.0 * freq_cutoff < sampling_freq)) {
+            return {};
+        }
+
+        Pole_Zero analog = analog_prototype(prototype, order, ripple);
+        if (analog.poles.empty()) {
+            return {};
+        }
+
+        std::vector<double> sections = zpk_to_sos(bilinear_zpk(analog, sampling_freq, freq_cutoff, highpass), highpass ? M_PI : 0.0);
+        return std::vector<T>(sections.begin(), sections.end());
+    }
+
+    /**
+     * @brief Specification of IIR lowpass/highpass response for design with minimal order (see elliptic_lowpass_coeff()).
+     * * Lowpass has freq_pass < freq_stop, highpass has freq_stop < freq_pass.
+     */
+    struct IIR_Spec {
+        double freq_pass;
+        double freq_stop;
+        double pass_ripple;     // peak-to-peak passband ripple in dB
+        double stop_atten;      // minimal stopband attenuation in dB
+    };
+
+    /**
+     * @brief Specification of IIR bandpass/bandstop response for design with minimal order (see elliptic_bandpass_coeff()).
+     * * Bandpass has freq_stop_low < freq_pass_low < freq_pass_high < freq_stop_high,
+     * * bandstop has freq_pass_low < freq_stop_low < freq_stop_high < freq_pass_high.
+     */
+    struct IIR_Band_Spec {
+        double freq_pass_low;
+        double freq_pass_high;
+        double freq_stop_low;
+        double freq_stop_high;
+        double pass_ripple;
+        double stop_atten;
+    };
+
+    /**
+     * @brief Descending Landen sequence of moduli used by elliptic functions below.
+     * * Sequence is driven by complementary modulus, so moduli close to 1 keep their precision.
+     * @param complement Complementary modulus sqrt(1 - k^2).
+     * @return Returns moduli k1, k2, ... until they drop below 1e-16.
+     */
+    inline std::vector<double> landen(double complement) {
+        std::vector<double> moduli;
+        for (int n = 0; n < 32; n++) {
+            double modulus = (1.0 - complement) / (1.0 + complement);
+            if (modulus < 1e-16) {
+                break;
+            }
+            moduli.push_back(modulus);
+            complement = 2.0 * std::sqrt(complement) / (1.0 + complement);
+        }
+        return moduli;
+    }
+
+    /**
+     * @brief Complete elliptic integral of the first kind K.
+     * @param complement Complementary modulus, K(k) for complement sqrt(1 - k^2), K'(k) for complement k.
+     */
+    inline double elliptic_k(double complement) {
+        double result = M_PI / 2.0;
+        for (double modulus : landen(complement)) {
+            result *= 1.0 + modulus;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Jacobi elliptic function cd(u K, k) (or sn(u K, k)) for complex u in units of quarter period K.
+     * @param u Complex argument normalized by K.
+     * @param modulus Modulus k.
+     * @param sine True for sn, false for cd.
+     */
+    inline std::complex<double> jacobi_cd_sn(std::complex<double> u, double modulus, bool sine) {
+        std::vector<double> moduli = landen(std::sqrt(1.0 - modulus * modulus));
+        std::complex<double> w = sine ? std::sin(u * M_PI / 2.0) : std::cos(u * M_PI / 2.0);
+        for (std::size_t n = moduli.size(); n-- > 0;) {
+            w = (1.0 + moduli[n]) * w / (1.0 + moduli[n] * w * w);
+        }
+        return w;
+    }
+
+    /**
+     * @brief Inverse of sn(u K, k) for complex value.
+     * @return Returns u normalized by K.
+     */
+    inline std::complex<double> jacobi_asn(std::complex<double> w, double modulus) {
+        std::vector<double> moduli = landen(std::sqrt(1.0 - modulus * modulus));
+        double previous = modulus;
+        for (double next : moduli) {
+            w = w / (1.0 + std::sqrt(1.0 - w * w * previous * previous)) * 2.0 / (1.0 + next);
+            previous = next;
+        }
+        return std::asin(w) * 2.0 / M_PI;
+    }
+
+    /**
+     * @brief Selectivity of elliptic filter of given order from it's discrimination (solution of degree equation by nome series).
+     * @param order Integer type order of filter.
+     * @param discrimination eps_pass / eps_stop.
+     * @return Returns modulus k = passband edge / stopband edge.
+     */
+    inline double elliptic_degree(int order, double discrimination) {
+        double nome = std::exp(-M_PI * elliptic_k(discrimination) / (order * elliptic_k(std::sqrt(1.0 - discrimination * discrimination))));
+        double numerator = 0.0, denominator = 1.0;
+        for (int m = 0; m < 8; m++) {
+            numerator += std::pow(nome, m * (m + 1.0));
+            if (m > 0) {
+                denominator += 2.0 * std::pow(nome, static_cast<double>(m * m));
+            }
+        }
+        return 4.0 * std::sqrt(nome) * std::pow(numerator / denominator, 2.0);
+    }
+
+    /**
+     * @brief Minimal order of elliptic lowpass prototype, N = K(k) K'(k1) / (K'(k) K(k1)) rounded up.
+     * @param stop_edge Stopband edge of prototype with passband edge 1 (greater than 1).
+     * @param pass_ripple Passband ripple in dB.
+     * @param stop_atten Stopband attenuation in dB.
+     * @return Returns order, 0 if parameters are not valid.
+     */
+    inline int elliptic_min_order(double stop_edge, double pass_ripple, double stop_atten) {
+        if (!(stop_edge > 1.0) || !(pass_ripple > 0.0) || !(stop_atten > pass_ripple)) {
+            return 0;
+        }
+
+        const double selectivity = 1.0 / stop_edge;
+        const double discrimination = std::sqrt((std::pow(10.0, pass_ripple / 10.0) - 1.0) / (std::pow(10.0, stop_atten / 10.0) - 1.0));
+        double order = elliptic_k(std::sqrt(1.0 - selectivity * selectivity)) * elliptic_k(discrimination)
+                     / (elliptic_k(selectivity) * elliptic_k(std::sqrt(1.0 - discrimination * discrimination)));
+        return std::max(1, static_cast<int>(std::ceil(order - 1e-9)));
+    }
+
+    /**
+     * @brief Analog elliptic (Cauer) lowpass prototype with passband edge 1 rad/s.
+     * * Passband ripple is kept exactly, stopband edge 1 / k follows from order by degree equation, so for order from
+     * * elliptic_min_order() transition is not wider than specified.
+     * @param order Integer type order of filter.
+     * @param pass_ripple Passband ripple in dB.
+     * @param stop_atten Stopband attenuation in dB.
+     * @return Returns zeros, poles and gain, empty if parameters are not valid.
+     */
+    inline Pole_Zero elliptic_prototype(int order, double pass_ripple, double stop_atten) {
+        Pole_Zero result;
+        if (order < 1 || !(pass_ripple > 0.0) || !(stop_atten > pass_ripple)) {
+            return result;
+        }
+
+        const double eps_pass = std::sqrt(std::pow(10.0, pass_ripple / 10.0) - 1.0);
+        const double eps_stop = std::sqrt(std::pow(10.0, stop_atten / 10.0) - 1.0);
+        const double discrimination = eps_pass / eps_stop;
+        const double selectivity = elliptic_degree(order, discrimination);
+        const std::complex<double> j(0.0, 1.0);
+
+        // imaginary shift of poles from zeros, v0 = asn(j / eps_pass, k1) / (j N)
+        const std::complex<double> shift = -j * jacobi_asn(j / eps_pass, discrimination) / static_cast<double>(order);
+
+        for (int i = 1; i <= order / 2; i++) {
+            const double u = (2.0 * i - 1.0) / order;
+            const std::complex<double> zero = j / (selectivity * jacobi_cd_sn(u, selectivity, false));
+            const std::complex<double> pole = j * jacobi_cd_sn(u - j * shift, selectivity, false);
+            result.zeros.insert(result.zeros.end(), {zero, std::conj(zero)});
+            result.poles.insert(result.poles.end(), {pole, std::conj(pole)});
+        }
+        if (order % 2 == 1) {
+            result.poles.emplace_back((j * jacobi_cd_sn(j * shift, selectivity, true)).real(), 0.0);
+        }
+        else {
+            result.gain = 1.0 / std::sqrt(1.0 + eps_pass * eps_pass);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Transforms analog lowpass prototype to digital bandpass or bandstop by bilinear transform with prewarping.
+     * * Every root of prototype gives two roots, zeros at infinity end at z = 1 and z = -1 (bandpass) or on the unit
+     * * circle at center frequency (bandstop).
+     * @param analog Prototype with passband edge 1.
+     * @param sampling_freq Double type sampling frequency.
+     * @param freq_low Double type lower passband edge (bandpass) or lower edge of passband below stop band (bandstop).
+     * @param freq_high Double type upper edge.
+     * @param bandstop True for bandstop transformation.
+     * @return Returns digital zeros, poles and gain (gain at center frequency for bandpass, at DC for bandstop).
+     */
+    inline Pole_Zero bilinear_band_zpk(const Pole_Zero& analog, double sampling_freq, double freq_low, double freq_high, bool bandstop) {
+        const double low = std::tan(M_PI * freq_low / sampling_freq);
+        const double high = std::tan(M_PI * freq_high / sampling_freq);
+        const double center2 = low * high;
+        const double width = high - low;
+
+        auto transform = [&](const std::vector<std::complex<double>>& roots, std::vector<std::complex<double>>& digital) {
+            for (const std::complex<double>& root : roots) {
+                std::complex<double> s[2];
+                if (bandstop) {
+                    std::complex<double> disc = std::sqrt(width * width - 4.0 * root * root * center2);
+                    s[0] = (width + disc) / (2.0 * root);
+                    s[1] = (width - disc) / (2.0 * root);
+                }
+                else {
+                    std::complex<double> disc = std::sqrt(root * root * width * width - 4.0 * center2);
+                    s[0] = (root * width + disc) / 2.0;
+                    s[1] = (root * width - disc) / 2.0;
+                }
+                digital.push_back((1.0 + s[0]) / (1.0 - s[0]));
+                digital.push_back((1.0 + s[1]) / (1.0 - s[1]));
+            }
+        };
+
+        Pole_Zero result;
+        result.gain = analog.gain;
+        transform(analog.poles, result.poles);
+        transform(analog.zeros, result.zeros);
+
+        const std::complex<double> notch = (1.0 + std::complex<double>(0.0, std::sqrt(center2))) / (1.0 - std::complex<double>(0.0, std::sqrt(center2)));
+        for (std::size_t i = analog.zeros.size(); i < analog.poles.size(); i++) {
+            if (bandstop) {
+                result.zeros.insert(result.zeros.end(), {notch, std::conj(notch)});
+            }
+            else {
+                result.zeros.insert(result.zeros.end(), {std::complex<double>(1.0), std::complex<double>(-1.0)});
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Calculates elliptic lowpass or highpass of minimal order meeting the specification as second order sections.
+     * * Passband edge is kept exactly, stopband edge is at or inside the specified one.
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, passband ripple and stopband attenuation (highpass if freq_stop < freq_pass).
+     * @param order Optional pointer filled with order of design (0 if specification is invalid).
+     * @return Returns sections b0, b1, b2, a1, a2 one after another, empty if specification is invalid.
+     */
+    template <typename T>
+    std::vector<T> elliptic_design_coeff(double sampling_freq, const IIR_Spec& spec, int* order = nullptr) {
+        if (order) {
+            *order = 0;
+        }
+        const double nyquist = sampling_freq / 2.0;
+        if (!(spec.freq_pass > 0.0 && spec.freq_pass < nyquist && spec.freq_stop > 0.0 && spec.freq_stop < nyquist)) {
+            return {};
+        }
+
+        const bool highpass = spec.freq_stop < spec.freq_pass;
+        const double pass = std::tan(M_PI * spec.freq_pass / sampling_freq);
+        const double stop = std::tan(M_PI * spec.freq_stop / sampling_freq);
+        const int result_order = elliptic_min_order(highpass ? pass / stop : stop / pass, spec.pass_ripple, spec.stop_atten);
+        if (result_order == 0) {
+            return {};
+        }
+
+        if (order) {
+            *order = result_order;
+        }
+        Pole_Zero analog = elliptic_prototype(result_order, spec.pass_ripple, spec.stop_atten);
+        std::vector<double> sections = zpk_to_sos(bilinear_zpk(analog, sampling_freq, spec.freq_pass, highpass), highpass ? M_PI : 0.0);
+        return std::vector<T>(sections.begin(), sections.end());
+    }
+
+    /**
+     * @brief Calculates elliptic bandpass or bandstop of minimal order meeting the specification as second order sections.
+     * * Prototype order is found for the narrower of both transition bands, filter order is twice the prototype order.
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, passband ripple and stopband attenuation.
+     * @param bandstop True for bandstop, false for bandpass.
+     * @param order Optional pointer filled with order of design (0 if specification is invalid).
+     * @return Returns sections b0, b1, b2, a1, a2 one after another, empty if specification is invalid.
+     */
+    template <typename T>
+    std::vector<T> elliptic_band_design_coeff(double sampling_freq, const IIR_Band_Spec& spec, bool bandstop, int* order = nullptr) {
+        if (order) {
+            *order = 0;
+        }
+        const double nyquist = sampling_freq / 2.0;
+        const bool ordered = bandstop
+            ? 0.0 < spec.freq_pass_low && spec.freq_pass_low < spec.freq_stop_low && spec.freq_stop_low < spec.freq_stop_high && spec.freq_stop_high < spec.freq_pass_high
+            : 0.0 < spec.freq_stop_low && spec.freq_stop_low < spec.freq_pass_low && spec.freq_pass_low < spec.freq_pass_high && spec.freq_pass_high < spec.freq_stop_high;
+        if (!ordered || !(std::max(spec.freq_pass_high, spec.freq_stop_high) < nyquist)) {
+            return {};
+        }
+
+        const double low = std::tan(M_PI * spec.freq_pass_low / sampling_freq);
+        const double high = std::tan(M_PI * spec.freq_pass_high / sampling_freq);
+        double stop_edge = HUGE_VAL;
+        for (double freq : {spec.freq_stop_low, spec.freq_stop_high}) {
+            const double omega = std::tan(M_PI * freq / sampling_freq);
+            const double edge = std::fabs((omega * omega - low * high) / ((high - low) * omega));
+            stop_edge = std::min(stop_edge, bandstop ? 1.0 / edge : edge);
+        }
+
+        const int prototype_order = elliptic_min_order(stop_edge, spec.pass_ripple, spec.stop_atten);
+        if (prototype_order == 0) {
+            return {};
+        }
+
+        if (order) {
+            *order = 2 * prototype_order;
+        }
+        Pole_Zero analog = elliptic_prototype(prototype_order, spec.pass_ripple, spec.stop_atten);
+        const double center = 2.0 * std::atan(std::sqrt(low * high));
+        std::vector<double> sections = zpk_to_sos(bilinear_band_zpk(analog, sampling_freq, spec.freq_pass_low, spec.freq_pass_high, bandstop),
+                                                  bandstop ? 0.0 : center);
+        return std::vector<T>(sections.begin(), sections.end());
+    }
+
+    /**
+     * @brief Elliptic lowpass of minimal order (see elliptic_design_coeff()).
+     * @return Returns sections, empty if specification is not lowpass or is invalid.
+     */
+    template <typename T>
+    std::vector<T> elliptic_lowpass_coeff(double sampling_freq, const IIR_Spec& spec, int* order = nullptr) {
+        if (!(spec.freq_pass < spec.freq_stop)) {
+            if (order) {
+                *order = 0;
+            }
+            return {};
+        }
+        return elliptic_design_coeff<T>(sampling_freq, spec, order);
+    }
+
+    /**
+     * @brief Elliptic highpass of minimal order (see elliptic_design_coeff()).
+     * @return Returns sections, empty if specification is not highpass or is invalid.
+     */
+    template <typename T>
+    std::vector<T> elliptic_highpass_coeff(double sampling_freq, const IIR_Spec& spec, int* order = nullptr) {
+        if (!(spec.freq_stop < spec.freq_pass)) {
+            if (order) {
+                *order = 0;
+            }
+            return {};
+        }
+        return elliptic_design_coeff<T>(sampling_freq, spec, order);
+    }
+
+    /**
+     * @brief Elliptic bandpass of minimal order (see elliptic_band_design_coeff()).
+     */
+    template <typename T>
+    std::vector<T> elliptic_bandpass_coeff(double sampling_freq, const IIR_Band_Spec& spec, int* order = nullptr) {
+        return elliptic_band_design_coeff<T>(sampling_freq, spec, false, order);
+    }
+
+    /**
+     * @brief Elliptic bandstop of minimal order (see elliptic_band_design_coeff()).
+     */
+    template <typename T>
+    std::vector<T> elliptic_bandstop_coeff(double sampling_freq, const IIR_Band_Spec& spec, int* order = nullptr) {
+        return elliptic_band_design_coeff<T>(sampling_freq, spec, true, order);
+    }
+
+}
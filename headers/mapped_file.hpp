@@ -0,0 +1,198 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define AF_MMAP
+#endif
+
+namespace af{
+
+    /**
+     * @brief Mapped_File keeps read-only memory map of a file (or it's copy in memory where mmap is not available).
+     */
+    class Mapped_File {
+        private:
+            const unsigned char* m_data = nullptr;
+            std::size_t m_size = 0;
+#ifdef AF_MMAP
+            void* m_map = nullptr;
+#else
+            std::vector<std::uint64_t> m_buffer;
+#endif
+
+        public:
+
+            /**
+             * @brief Constructor mapping file. Check is_open() for result.
+             * @param path Path of file.
+             */
+            explicit Mapped_File(const std::string& path) {
+#ifdef AF_MMAP
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    return;
+                }
+
+                struct stat info;
+                if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+                    void* map = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (map != MAP_FAILED) {
+                        m_map = map;
+                        m_data = static_cast<const unsigned char*>(map);
+                        m_size = static_cast<std::size_t>(info.st_size);
+                    }
+                }
+                ::close(fd);
+#else
+                std::ifstream file(path, std::ios::binary | std::ios::ate);
+                if (!file) {
+                    return;
+                }
+
+                std::size_t size = static_cast<std::size_t>(file.tellg());
+                m_buffer.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+                file.seekg(0);
+                if (file.read(reinterpret_cast<char*>(m_buffer.data()), size)) {
+                    m_data = reinterpret_cast<const unsigned char*>(m_buffer.data());
+                    m_size = size;
+                }
+#endif
+            }
+
+            ~Mapped_File() {
+#ifdef AF_MMAP
+                if (m_map) {
+                    ::munmap(m_map, m_size);
+                }
+#endif
+            }
+
+            Mapped_File(const Mapped_File&) = delete;
+            Mapped_File& operator=(const Mapped_File&) = delete;
+
+            bool is_open() const {
+                return m_data != nullptr;
+            }
+
+            const unsigned char* data() const {
+                return m_data;
+            }
+
+            std::size_t size() const {
+                return m_size;
+            }
+
+            /**
+             * @brief Hints the system that file will be read once from start to end (read-ahead, early page release).
+             */
+            void advise_sequential() const {
+#ifdef AF_MMAP
+                if (m_map) {
+                    ::posix_madvise(m_map, m_size, POSIX_MADV_SEQUENTIAL);
+                }
+#endif
+            }
+    };
+
+
+    /**
+     * @brief Mapped_Output_File creates file of given size and keeps writable memory map of it
+     * * (or buffer in memory written to file by close() where mmap is not available).
+     */
+    class Mapped_Output_File {
+        private:
+            std::string m_path;
+            unsigned char* m_data = nullptr;
+            std::size_t m_size = 0;
+#ifdef AF_MMAP
+            void* m_map = nullptr;
+#else
+            std::vector<std::uint64_t> m_buffer;
+#endif
+
+        public:
+
+            /**
+             * @brief Constructor creating (or truncating) file and mapping it. Check is_open() for result.
+             * @param path Path of file.
+             * @param size Size of file in bytes, must be greater than 0.
+             */
+            Mapped_Output_File(const std::string& path, std::size_t size) : m_path(path) {
+                if (size == 0) {
+                    return;
+                }
+#ifdef AF_MMAP
+                int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (fd < 0) {
+                    return;
+                }
+
+                if (::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+                    void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    if (map != MAP_FAILED) {
+                        m_map = map;
+                        m_data = static_cast<unsigned char*>(map);
+                        m_size = size;
+                    }
+                }
+                ::close(fd);
+#else
+                m_buffer.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+                m_data = reinterpret_cast<unsigned char*>(m_buffer.data());
+                m_size = size;
+#endif
+            }
+
+            ~Mapped_Output_File() {
+                close();
+            }
+
+            Mapped_Output_File(const Mapped_Output_File&) = delete;
+            Mapped_Output_File& operator=(const Mapped_Output_File&) = delete;
+
+            /**
+             * @brief Unmaps file (or writes buffer to file). Called by destructor.
+             * @return Returns true if all data was written.
+             */
+            bool close() {
+                if (!m_data) {
+                    return false;
+                }
+
+                bool ok = true;
+#ifdef AF_MMAP
+                ok = ::munmap(m_map, m_size) == 0;
+                m_map = nullptr;
+#else
+                std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(m_data), static_cast<std::streamsize>(m_size));
+                ok = static_cast<bool>(file);
+                m_buffer.clear();
+#endif
+                m_data = nullptr;
+                return ok;
+            }
+
+            bool is_open() const {
+                return m_data != nullptr;
+            }
+
+            unsigned char* data() const {
+                return m_data;
+            }
+
+            std::size_t size() const {
+                return m_size;
+            }
+    };
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <string>
+#include <complex>
+#include <cstddef>
+#include <algorithm>
+#include "fft.hpp"
+#include "filter_type.hpp"
+
+namespace af{
+
+    /**
+     * @brief Result of min_phase_coeff(). Delays are in samples, averaged over passband (magnitude within -3 dB of peak)
+     * * with weight |H|^2, so one number describes latency of the filter.
+     */
+    struct Min_Phase_Report {
+        double delay_before = 0.0;
+        double delay_after = 0.0;
+        double max_error_db = 0.0;      // largest magnitude difference in passband
+    };
+
+    /**
+     * @brief Helper calculating passband group delay and magnitude of FIR on FFT grid.
+     * @param coeff Coeffitients of filter.
+     * @param size FFT size (power of two, not smaller than number of coeffitients).
+     * @param magnitude Filled with |H| for bins 0 .. size / 2.
+     * @return Returns |H|^2 weighted mean group delay in passband (samples).
+     */
+    template <typename T>
+    double passband_group_delay(const std::vector<T>& coeff, std::size_t size, std::vector<double>& magnitude) {
+        std::vector<std::complex<double>> response(size), ramp(size);
+        for (std::size_t n = 0; n < coeff.size(); n++) {
+            response[n] = static_cast<double>(coeff[n]);
+            ramp[n] = static_cast<double>(n) * static_cast<double>(coeff[n]);
+        }
+        fft(response);
+        fft(ramp);
+
+        magnitude.resize(size / 2 + 1);
+        double peak = 0.0;
+        for (std::size_t k = 0; k <= size / 2; k++) {
+            magnitude[k] = std::abs(response[k]);
+            peak = std::max(peak, magnitude[k]);
+        }
+
+        double sum = 0.0, weight = 0.0;
+        for (std::size_t k = 0; k <= size / 2; k++) {
+            if (magnitude[k] >= peak * M_SQRT1_2) {
+                double power = magnitude[k] * magnitude[k];
+                sum += (ramp[k] * std::conj(response[k])).real();
+                weight += power;
+            }
+        }
+        return weight > 0.0 ? sum / weight : 0.0;
+    }
+
+    /**
+     * @brief Converts FIR coeffitients to minimum phase FIR of the same length and magnitude response (homomorphic method).
+     * * Real cepstrum of log |H| is folded to causal part and exponentiated, so all zeros end up inside the unit circle
+     * * and energy of impulse response moves to the start. Zeros of linear phase designs on the unit circle (stopband)
+     * * are limited to -140 dB below peak before logarithm. FFT is 32 times longer than filter to keep cepstral aliasing low.
+     * * Phase is no longer linear, so waveform of passband signal changes, only magnitude is kept.
+     * @param coeff Coeffitients of filter (for example Lowpass::get_coeff()).
+     * @param report Optional pointer filled with passband group delay before and after conversion and magnitude error.
+     * @return Returns minimum phase coeffitients, empty if input is empty.
+     */
+    template <typename T>
+    std::vector<T> min_phase_coeff(const std::vector<T>& coeff, Min_Phase_Report* report = nullptr) {
+        if (coeff.empty()) {
+            return {};
+        }
+
+        const std::size_t size = fft_size(std::max<std::size_t>(32 * coeff.size(), 1024));
+        std::vector<std::complex<double>> spectrum(size);
+        for (std::size_t n = 0; n < coeff.size(); n++) {
+            spectrum[n] = static_cast<double>(coeff[n]);
+        }
+        fft(spectrum);
+
+        double peak = 0.0;
+        for (const std::complex<double>& value : spectrum) {
+            peak = std::max(peak, std::abs(value));
+        }
+        const double floor = std::max(peak * 1e-7, 1e-300);
+
+        // real cepstrum of log magnitude
+        for (std::complex<double>& value : spectrum) {
+            value = std::log(std::max(std::abs(value), floor));
+        }
+        fft(spectrum, true);
+
+        // fold to causal cepstrum: c[0], 2 c[n] for 0 < n < size / 2, c[size / 2]
+        for (std::size_t n = 1; n < size / 2; n++) {
+            spectrum[n] = 2.0 * spectrum[n].real();
+        }
+        spectrum[0] = spectrum[0].real();
+        spectrum[size / 2] = spectrum[size / 2].real();
+        std::fill(spectrum.begin() + static_cast<std::ptrdiff_t>(size / 2 + 1), spectrum.end(), std::complex<double>(0.0));
+
+        fft(spectrum);
+        for (std::complex<double>& value : spectrum) {
+            value = std::exp(value);
+        }
+        fft(spectrum, true);
+
+        std::vector<T> result(coeff.size());
+        for (std::size_t n = 0; n < result.size(); n++) {
+            result[n] = static_cast<T>(spectrum[n].real());
+        }
+
+        if (report) {
+            const std::size_t grid = fft_size(std::max<std::size_t>(8 * coeff.size(), 1024));
+            std::vector<double> before, after;
+            report->delay_before = passband_group_delay(coeff, grid, before);
+            report->delay_after = passband_group_delay(result, grid, after);
+
+            double before_peak = *std::max_element(before.begin(), before.end());
+            report->max_error_db = 0.0;
+            for (std::size_t k = 0; k < before.size(); k++) {
+                if (before[k] >= before_peak * M_SQRT1_2 && after[k] > 0.0) {
+                    report->max_error_db = std::max(report->max_error_db, std::fabs(20.0 * std::log10(after[k] / before[k])));
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Builds minimum phase copy of FIR filter (see min_phase_coeff()).
+     * @param filter Filter with linear phase (or any) coeffitients.
+     * @param report Optional pointer filled with group delay before and after conversion.
+     * @return Returns new FIR filter with the same sampling frequency and name, empty coeffitients if filter has none.
+     */
+    template <typename T>
+    FIR<T> min_phase(const FIR<T>& filter, Min_Phase_Report* report = nullptr) {
+        const Shared_Coeff<T>& coeff = filter.get_coeff();
+        std::vector<T> values(coeff.data(), coeff.data() + coeff.size());
+
+        FIR<T> result(filter.get_sampling_freq(), filter.get_filter_name());
+        result.set_coeff(min_phase_coeff(values, report));
+        return result;
+    }
+
+}
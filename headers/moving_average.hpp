@@ -0,0 +1,470 @@
+#pragma once
+
+#include "base_filter.hpp"
+#include "filter_state.hpp"
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+
+namespace af{
+
+    /**
+     * @brief Response of averaging filter of given length (1 / L) sum z^-n, 1 at DC.
+     * @param length Number of averaged samples.
+     * @param omega Normalized frequency (2 pi f / fs).
+     * @return Returns value of transfer function e^(-jw(L-1)/2) sin(L w / 2) / (L sin(w / 2)).
+     */
+    inline std::complex<double> boxcar_response(std::size_t length, double omega) {
+        const double half = 0.5 * omega;
+        const double denominator = static_cast<double>(length) * std::sin(half);
+        const double magnitude = std::fabs(denominator) < 1e-300 ? 1.0 : std::sin(static_cast<double>(length) * half) / denominator;
+        return std::polar(magnitude, -half * static_cast<double>(length - 1));
+    }
+
+    /**
+     * @brief MovingAverage class is running sum filter, output is gain times sum of last length samples.
+     * * Cost is O(1) per sample for any length (FIR with equal coeffitients costs O(length)).
+     * * Floating point running sum is restarted every length samples from second sum of the same window,
+     * * so rounding errors do not accumulate (no drift for arbitrarily long signals).
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class MovingAverage : public Base_Filter<T> {
+        private:
+            std::vector<T> m_ring;
+            std::size_t m_index = 0;
+            T m_gain;
+            T m_sum = static_cast<T>(0);
+            T m_fresh = static_cast<T>(0);
+
+            /**
+             * @brief Helper moving one sample through running sum.
+             * @param input Input sample.
+             * @return Returns sum of last length samples.
+             */
+            T step(T input) {
+                T& oldest = m_ring[m_index];
+                m_sum += input - oldest;
+                m_fresh += input;
+                oldest = input;
+
+                if (++m_index == m_ring.size()) {
+                    // fresh sum holds exactly the samples in the window
+                    m_index = 0;
+                    m_sum = m_fresh;
+                    m_fresh = static_cast<T>(0);
+                }
+                return m_sum;
+            }
+
+        protected:
+
+            /**
+             * @brief Writes window, sums and position as binary state (see Base_Filter::save_state()).
+             * @param buffer Pointer to state buffer of at least state_size() bytes.
+             * @return Returns number of written bytes.
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                const T sums[2] = {m_sum, m_fresh};
+                const std::uint32_t index = static_cast<std::uint32_t>(m_index);
+                unsigned char* position = state_put_count(buffer, static_cast<std::uint32_t>(m_ring.size()));
+                position = state_put(position, m_ring.data(), m_ring.size());
+                position = state_put(position, sums, 2);
+                position = state_put(position, &index, 1);
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads state into existing memory (see Base_Filter::load_state()).
+             * @param buffer Pointer to state buffer.
+             * @param size Number of bytes available in buffer.
+             * @return Returns number of read bytes, 0 if state does not match length of filter.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                const unsigned char* end = buffer + size;
+                T sums[2];
+                std::uint32_t index;
+
+                if (!state_get_count(position, end, static_cast<std::uint32_t>(m_ring.size()))
+                    || !state_get(position, end, m_ring.data(), m_ring.size())
+                    || !state_get(position, end, sums, 2)
+                    || !state_get(position, end, &index, 1)
+                    || index >= m_ring.size()) {
+                    return 0;
+                }
+
+                m_sum = sums[0];
+                m_fresh = sums[1];
+                m_index = index;
+                return position - buffer;
+            }
+
+        public:
+            using Base_Filter<T>::frequency_response;
+
+            /**
+             * @brief Parametric constructor of MovingAverage filter object.
+             * @param sampling_freq Double type sampling frequency.
+             * @param filter_name String type name of filter.
+             * @param length Number of averaged samples (at least 1).
+             * @param gain Factor of sum, default 1 / length gives unity gain at DC.
+             */
+            MovingAverage(double sampling_freq, std::string filter_name, std::size_t length, T gain) :
+                Base_Filter<T>(sampling_freq, filter_name), m_ring(std::max<std::size_t>(length, 1), static_cast<T>(0)), m_gain(gain) {}
+
+            /**
+             * @brief Parametric constructor of MovingAverage filter object with unity gain at DC.
+             * @param sampling_freq Double type sampling frequency.
+             * @param filter_name String type name of filter.
+             * @param length Number of averaged samples (at least 1).
+             */
+            MovingAverage(double sampling_freq, std::string filter_name, std::size_t length) :
+                MovingAverage(sampling_freq, filter_name, length, static_cast<T>(1) / static_cast<T>(std::max<std::size_t>(length, 1))) {}
+
+            /**
+             * @brief Getter of number of averaged samples.
+             */
+            std::size_t get_length() const{
+                return m_ring.size();
+            }
+
+            /**
+             * @brief Getter of factor of sum.
+             */
+            T get_gain() const{
+                return m_gain;
+            }
+
+            /**
+             * @brief Group delay of filter, constant (length - 1) / 2 samples.
+             */
+            double group_delay(double) const override{
+                return 0.5 * static_cast<double>(m_ring.size() - 1);
+            }
+
+            /**
+             * @brief Frequency response in closed form (see boxcar_response()).
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override{
+                const double scale = static_cast<double>(m_gain) * static_cast<double>(m_ring.size());
+                for (std::size_t i = 0; i < count; i++) {
+                    response[i] = scale * boxcar_response(m_ring.size(), 2.0 * M_PI * freq[i] / this->get_sampling_freq());
+                }
+            }
+
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             */
+            std::size_t state_size() const override{
+                return 2 * sizeof(std::uint32_t) + (m_ring.size() + 2) * sizeof(T);
+            }
+
+            /**
+             * @brief Method for reseting filter's internal memory.
+             */
+            void reset() override{
+                std::fill(m_ring.begin(), m_ring.end(), static_cast<T>(0));
+                m_index = 0;
+                m_sum = static_cast<T>(0);
+                m_fresh = static_cast<T>(0);
+            }
+
+            /**
+             * @brief Method for filtering a sample of input signal.
+             * @param input Numerical type input sample.
+             * @return Filtered numerical type input sample (same as input type).
+             */
+            T filter(T input) override{
+                AF_RT_SCOPE();
+                return m_gain * step(this->get_flush_denormals() ? flush_tiny(input) : input);
+            }
+
+            /**
+             * @brief Method for filtering a block of samples.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                const bool flush = this->get_flush_denormals();
+
+                for (std::size_t i = 0; i < length; i++) {
+                    output[i] = m_gain * step(flush ? flush_tiny(input[i]) : input[i]);
+                }
+            }
+
+            /**
+             * @brief Method for cloning it's self - used to make cascades
+             */
+            std::unique_ptr<Base_Filter<T>> clone() const override {
+                return std::make_unique<MovingAverage<T>>(*this);
+            }
+
+    };
+
+    /**
+     * @brief Rate change of CIC filter.
+     */
+    enum class CIC_Mode { Decimator, Interpolator };
+
+    /**
+     * @brief CIC class is cascaded integrator-comb decimator or interpolator with response (sum of rate * delay samples)^stages.
+     * * Integer CIC relies on wrap-around of integrators, floating point integrators would lose precision without bound.
+     * * Here every integrator-comb pair is running sum with periodic restart (see MovingAverage), so cost is O(stages)
+     * * per sample at the high rate for any rate and delay, and there is no drift. Output is normalized to unity DC gain.
+     * * filter() and filter_block() run the filter at rate of it's input without rate change (decimator: anti-aliasing
+     * * at input rate, interpolator: smoothing of already upsampled signal), process() changes the rate.
+     * @tparam T is sample input type numeric data.
+     */
+    template <typename T>
+    class CIC : public Base_Filter<T> {
+        private:
+            CIC_Mode m_mode;
+            std::size_t m_stages;
+            std::size_t m_rate;
+            std::size_t m_delay;
+            std::size_t m_length;
+            std::vector<T> m_ring;      // stages * length samples
+            std::vector<T> m_sums;      // running sum and fresh sum of every stage
+            std::size_t m_index = 0;
+            std::size_t m_phase = 0;
+            T m_scale;
+
+            /**
+             * @brief Helper moving one sample through all stages at the high rate.
+             * @param input Input sample.
+             * @return Returns output of last stage (unity DC gain).
+             */
+            T step(T input) {
+                T* ring = m_ring.data() + m_index;
+                T* sums = m_sums.data();
+                for (std::size_t s = 0; s < m_stages; s++, ring += m_length, sums += 2) {
+                    sums[0] += input - *ring;
+                    sums[1] += input;
+                    *ring = input;
+                    input = sums[0] * m_scale;
+                }
+
+                if (++m_index == m_length) {
+                    m_index = 0;
+                    for (std::size_t s = 0; s < m_stages; s++) {
+                        m_sums[2 * s] = m_sums[2 * s + 1];
+                        m_sums[2 * s + 1] = static_cast<T>(0);
+                    }
+                }
+                return input;
+            }
+
+        protected:
+
+            /**
+             * @brief Writes windows, sums, position and phase as binary state (see Base_Filter::save_state()).
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                const std::uint32_t counters[2] = {static_cast<std::uint32_t>(m_index), static_cast<std::uint32_t>(m_phase)};
+                unsigned char* position = state_put_count(buffer, static_cast<std::uint32_t>(m_ring.size()));
+                position = state_put(position, m_ring.data(), m_ring.size());
+                position = state_put(position, m_sums.data(), m_sums.size());
+                position = state_put(position, counters, 2);
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads state into existing memory (see Base_Filter::load_state()).
+             * @return Returns number of read bytes, 0 if state does not match configuration of filter.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                const unsigned char* position = buffer;
+                const unsigned char* end = buffer + size;
+                std::uint32_t counters[2];
+
+                if (!state_get_count(position, end, static_cast<std::uint32_t>(m_ring.size()))
+                    || !state_get(position, end, m_ring.data(), m_ring.size())
+                    || !state_get(position, end, m_sums.data(), m_sums.size())
+                    || !state_get(position, end, counters, 2)
+                    || counters[0] >= m_length || counters[1] >= m_rate) {
+                    return 0;
+                }
+
+                m_index = counters[0];
+                m_phase = counters[1];
+                return position - buffer;
+            }
+
+        public:
+            using Base_Filter<T>::frequency_response;
+
+            /**
+             * @brief Parametric constructor of CIC filter object.
+             * @param sampling_freq Double type sampling frequency of input.
+             * @param filter_name String type name of filter.
+             * @param mode Decimator or Interpolator.
+             * @param stages Number of integrator-comb pairs (order of sinc^N response, at least 1).
+             * @param rate Decimation or interpolation factor (at least 1).
+             * @param delay Differential delay of combs in samples of the low rate (usually 1 or 2).
+             */
+            CIC(double sampling_freq, std::string filter_name, CIC_Mode mode, std::size_t stages, std::size_t rate, std::size_t delay = 1) :
+                Base_Filter<T>(sampling_freq, filter_name), m_mode(mode), m_stages(std::max<std::size_t>(stages, 1)),
+                m_rate(std::max<std::size_t>(rate, 1)), m_delay(std::max<std::size_t>(delay, 1)), m_length(m_rate * m_delay),
+                m_ring(m_stages * m_length, static_cast<T>(0)), m_sums(2 * m_stages, static_cast<T>(0)),
+                m_scale(static_cast<T>(1) / static_cast<T>(m_length)) {}
+
+            /**
+             * @brief Getter of rate change.
+             */
+            CIC_Mode get_mode() const{
+                return m_mode;
+            }
+
+            /**
+             * @brief Getter of number of stages.
+             */
+            std::size_t get_stages() const{
+                return m_stages;
+            }
+
+            /**
+             * @brief Getter of decimation or interpolation factor.
+             */
+            std::size_t get_rate() const{
+                return m_rate;
+            }
+
+            /**
+             * @brief Getter of differential delay.
+             */
+            std::size_t get_delay() const{
+                return m_delay;
+            }
+
+            /**
+             * @brief Getter of sampling frequency of output of process().
+             * @return Returns input frequency divided (decimator) or multiplied (interpolator) by rate.
+             */
+            double get_output_freq() const override{
+                return m_mode == CIC_Mode::Decimator ? this->get_sampling_freq() / static_cast<double>(m_rate)
+                                                     : this->get_sampling_freq() * static_cast<double>(m_rate);
+            }
+
+            /**
+             * @brief Number of samples written by process() for given input length in the worst case.
+             */
+            std::size_t max_output(std::size_t length) const override{
+                return m_mode == CIC_Mode::Decimator ? (length + m_rate - 1) / m_rate : length * m_rate;
+            }
+
+            /**
+             * @brief Group delay of filter, constant stages * (rate * delay - 1) / 2 samples of the high rate.
+             */
+            double group_delay(double) const override{
+                return 0.5 * static_cast<double>(m_stages) * static_cast<double>(m_length - 1);
+            }
+
+            /**
+             * @brief Frequency response of filter at the high rate (input rate of decimator, output rate of interpolator).
+             * @param freq Pointer to frequencies in Hz.
+             * @param response Pointer to count values of H written.
+             * @param count Number of frequencies.
+             */
+            void frequency_response(const double* freq, std::complex<double>* response, std::size_t count) const override{
+                const double rate = m_mode == CIC_Mode::Decimator ? this->get_sampling_freq() : get_output_freq();
+                for (std::size_t i = 0; i < count; i++) {
+                    response[i] = std::pow(boxcar_response(m_length, 2.0 * M_PI * freq[i] / rate), static_cast<int>(m_stages));
+                }
+            }
+
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             */
+            std::size_t state_size() const override{
+                return 3 * sizeof(std::uint32_t) + (m_ring.size() + m_sums.size()) * sizeof(T);
+            }
+
+            /**
+             * @brief Method for reseting filter's internal memory and phase of rate change.
+             */
+            void reset() override{
+                std::fill(m_ring.begin(), m_ring.end(), static_cast<T>(0));
+                std::fill(m_sums.begin(), m_sums.end(), static_cast<T>(0));
+                m_index = 0;
+                m_phase = 0;
+            }
+
+            /**
+             * @brief Method for filtering a sample without rate change.
+             * @param input Numerical type input sample.
+             * @return Filtered numerical type input sample (same as input type).
+             */
+            T filter(T input) override{
+                AF_RT_SCOPE();
+                return step(this->get_flush_denormals() ? flush_tiny(input) : input);
+            }
+
+            /**
+             * @brief Method for filtering a block of samples without rate change.
+             * @param input Pointer to block of input samples.
+             * @param output Pointer to block where filtered samples are written (can be the same as input).
+             * @param length Number of samples in block.
+             */
+            void filter_block(const T* input, T* output, std::size_t length) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                const bool flush = this->get_flush_denormals();
+
+                for (std::size_t i = 0; i < length; i++) {
+                    output[i] = step(flush ? flush_tiny(input[i]) : input[i]);
+                }
+            }
+
+            /**
+             * @brief Method for filtering block with rate change. Decimator keeps every rate-th output (phase continues
+             * * over blocks), interpolator inserts rate - 1 zeros after every input sample.
+             * @param input Pointer to block of input samples.
+             * @param length Number of input samples.
+             * @param output Pointer to at least max_output(length) samples (must not overlap input for interpolator).
+             * @return Returns number of written output samples.
+             */
+            std::size_t process(const T* input, std::size_t length, T* output) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                const bool flush = this->get_flush_denormals();
+                std::size_t count = 0;
+
+                if (m_mode == CIC_Mode::Decimator) {
+                    for (std::size_t i = 0; i < length; i++) {
+                        T y = step(flush ? flush_tiny(input[i]) : input[i]);
+                        if (++m_phase == m_rate) {
+                            m_phase = 0;
+                            output[count++] = y;
+                        }
+                    }
+                    return count;
+                }
+
+                const T zero = static_cast<T>(0);
+                const T gain = static_cast<T>(m_rate);
+                for (std::size_t i = 0; i < length; i++) {
+                    output[count++] = step(gain * (flush ? flush_tiny(input[i]) : input[i]));
+                    for (std::size_t r = 1; r < m_rate; r++) {
+                        output[count++] = step(zero);
+                    }
+                }
+                return count;
+            }
+
+            /**
+             * @brief Method for cloning it's self - used to make cascades
+             */
+            std::unique_ptr<Base_Filter<T>> clone() const override {
+                return std::make_unique<CIC<T>>(*this);
+            }
+
+    };
+
+}
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "filter_type.hpp"
+#include "filter_cascade.hpp"
+#include "FIRs.hpp"
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace af{
+
+    /**
+     * @brief Decimator class is FIR lowpass followed by keeping every factor-th sample (see process()).
+     * * Output is computed only for kept samples and memory is shifted once per output by all factor samples
+     * * (see FIR::push_samples()), so cost per input sample is number of nonzero taps / factor multiplications
+     * * and number of taps / factor moves (halfband taps are skipped as in FIR, see FIR::get_tap_layout()).
+     * @tparam T is type of numerical data to be used as input samples.
+     */
+    template <typename T>
+    class Decimator : public FIR<T> {
+        private:
+            std::size_t m_factor = 1;
+            std::size_t m_phase = 0;
+
+        protected:
+
+            /**
+             * @brief Writes filter memory and phase of decimation as binary state (see Base_Filter::save_state()).
+             */
+            std::size_t write_state(unsigned char* buffer) const override{
+                unsigned char* position = buffer + FIR<T>::write_state(buffer);
+                const std::uint32_t phase = static_cast<std::uint32_t>(m_phase);
+                position = state_put(position, &phase, 1);
+                return position - buffer;
+            }
+
+            /**
+             * @brief Reads filter memory and phase of decimation into existing memory (see Base_Filter::load_state()).
+             * @return Returns number of read bytes, 0 if state does not match filter.
+             */
+            std::size_t read_state(const unsigned char* buffer, std::size_t size) override{
+                std::size_t read = FIR<T>::read_state(buffer, size);
+                const unsigned char* position = buffer + read;
+                std::uint32_t phase = 0;
+
+                if (read == 0 || !state_get(position, buffer + size, &phase, 1) || phase >= m_factor) {
+                    return 0;
+                }
+
+                m_phase = phase;
+                return position - buffer;
+            }
+
+        public:
+
+            /**
+             * @brief Parametric constructor of Decimator object.
+             * @param sampling_freq Double type sampling frequency of input samples.
+             * @param filter_name String type name of filter.
+             * @param factor Decimation factor (1 keeps every sample).
+             * @param coeffitients Vector of coeffitients of anti-aliasing lowpass at input rate.
+             */
+            Decimator(double sampling_freq, std::string filter_name, std::size_t factor, const std::vector<T>& coeffitients)
+                : FIR<T>(sampling_freq, filter_name, coeffitients), m_factor(std::max<std::size_t>(factor, 1)) {}
+
+            /**
+             * @brief Parametric constructor of Decimator object from designed filter (for example halfband_lowpass()).
+             * @param filter FIR filter at input rate, coeffitients are shared (not copied).
+             * @param factor Decimation factor (1 keeps every sample).
+             */
+            Decimator(const FIR<T>& filter, std::size_t factor) : FIR<T>(filter), m_factor(std::max<std::size_t>(factor, 1)) {}
+
+            /**
+             * @brief Getter of decimation factor.
+             */
+            std::size_t get_factor() const{
+                return m_factor;
+            }
+
+            /**
+             * @brief Getter of sampling frequency of output of process().
+             * @return Returns input frequency divided by factor.
+             */
+            double get_output_freq() const override{
+                return this->get_sampling_freq() / static_cast<double>(m_factor);
+            }
+
+            /**
+             * @brief Number of samples written by process() for given input length in the worst case.
+             */
+            std::size_t max_output(std::size_t length) const override{
+                return (length + m_factor - 1) / m_factor;
+            }
+
+            /**
+             * @brief Getter of size of binary state (see Base_Filter::save_state()).
+             */
+            std::size_t state_size() const override{
+                return FIR<T>::state_size() + sizeof(std::uint32_t);
+            }
+
+            /**
+             * @brief Method for reseting filter memory and phase of decimation.
+             */
+            void reset() override{
+                FIR<T>::reset();
+                m_phase = 0;
+            }
+
+            /**
+             * @brief Method for filtering block with decimation, every factor-th output is computed and kept (phase continues
+             * * over blocks). Pending coeffitients are applied before first sample. Decimator without coeffitients keeps every
+             * * factor-th input sample unchanged.
+             * @param input Pointer to block of input samples.
+             * @param length Number of input samples.
+             * @param output Pointer to at least max_output(length) samples (can be the same as input).
+             * @return Returns number of written output samples.
+             */
+            std::size_t process(const T* input, std::size_t length, T* output) override{
+                AF_RT_SCOPE();
+                Denormal_Guard guard;
+                this->apply_pending_coeff();
+                std::size_t count = 0;
+
+                if (this->get_coeff().empty()) {
+                    for (std::size_t i = 0; i < length; i++) {
+                        if (++m_phase == m_factor) {
+                            m_phase = 0;
+                            output[count++] = input[i];
+                        }
+                    }
+                    return count;
+                }
+
+                for (std::size_t i = 0; i < length;) {
+                    const std::size_t group = std::min(m_factor - m_phase, length - i);
+                    this->push_samples(input + i, group);
+                    i += group;
+                    m_phase += group;
+                    if (m_phase == m_factor) {
+                        m_phase = 0;
+                        output[count++] = this->output_sample();
+                    }
+                }
+                return count;
+            }
+
+            /**
+             * @brief Method for cloning it's self - used to make cascades
+             */
+            std::unique_ptr<Base_Filter<T>> clone() const override {
+                return std::make_unique<Decimator<T>>(*this);
+            }
+    };
+
+    /**
+     * @brief Specification of multistage decimation (see decimation_chain()). Band from freq_pass to output_freq / 2
+     * * is transition band, aliases may fall only into it.
+     */
+    struct Decimation_Spec {
+        double freq_pass;
+        double output_freq;
+        double pass_ripple;     // peak-to-peak passband ripple of whole chain in dB
+        double stop_atten;      // minimal attenuation of aliases in dB
+    };
+
+    /**
+     * @brief One stage of decimation chain built by decimation_chain().
+     */
+    struct Decimation_Stage {
+        std::size_t factor;
+        double input_freq;
+        int order;
+        std::size_t active_taps;    // multiplications per output sample of stage
+        bool halfband;
+    };
+
+    /**
+     * @brief Stages of decimation chain and it's cost in multiplications per input sample of the chain.
+     */
+    struct Decimation_Plan {
+        std::vector<Decimation_Stage> stages;
+        double macs_per_input = 0.0;
+    };
+
+    /**
+     * @brief Helper estimating cost of decimation chain from Kaiser order formula (see kaiser_estimate()).
+     * * Stage decimating by 2 is halfband (half of taps nonzero), other stages are Kaiser lowpass.
+     * * Every stage has passband up to freq_pass and stopband from it's output frequency - freq_pass.
+     * @param input_freq Sampling frequency of input of chain.
+     * @param factors Decimation factors of stages in order.
+     * @param spec Specification of chain.
+     * @return Returns estimated multiplications per input sample.
+     */
+    inline double decimation_cost(double input_freq, const std::vector<std::size_t>& factors, const Decimation_Spec& spec) {
+        const double ripple = spec.pass_ripple / static_cast<double>(factors.size());
+        double freq = input_freq;
+        double cost = 0.0;
+
+        for (std::size_t factor : factors) {
+            const double output_freq = freq / static_cast<double>(factor);
+            const Kaiser_Params params = kaiser_estimate(freq, output_freq - 2.0 * spec.freq_pass, ripple, spec.stop_atten);
+            const double taps = factor == 2 ? 0.5 * static_cast<double>(params.order) + 2.0 : static_cast<double>(params.order) + 1.0;
+            cost += taps / static_cast<double>(factor) * freq / input_freq;
+            freq = output_freq;
+        }
+        return cost;
+    }
+
+    /**
+     * @brief Builds multistage decimator with minimal cost, as Cascade of Decimator stages.
+     * * Candidates are k halfband stages (decimating by 2) followed by at most two Kaiser lowpass stages dividing the rest
+     * * of integer factor (larger factor first). Each candidate is estimated by decimation_cost(), the cheapest one is designed.
+     * * Passband ripple budget is split evenly between stages, every stage has full stopband attenuation.
+     * @param input_freq Sampling frequency of input.
+     * @param cascade_name String name of cascade.
+     * @param spec Passband edge, output frequency (input_freq / output_freq has to be integer), ripple and attenuation.
+     * @param plan Optional pointer filled with stages and multiplications per input sample of built chain.
+     * @return Returns cascade (process() decimates), nullptr if specification is invalid.
+     */
+    template <typename T>
+    std::unique_ptr<Cascade<T>> decimation_chain(double input_freq, std::string cascade_name, const Decimation_Spec& spec, Decimation_Plan* plan = nullptr) {
+        if (plan) {
+            *plan = Decimation_Plan();
+        }
+        if (input_freq <= 0.0 || spec.output_freq <= 0.0 || spec.freq_pass <= 0.0 || 2.0 * spec.freq_pass >= spec.output_freq
+            || spec.pass_ripple <= 0.0 || spec.stop_atten <= 0.0) {
+            return nullptr;
+        }
+
+        const double ratio = input_freq / spec.output_freq;
+        const std::size_t factor = static_cast<std::size_t>(std::llround(ratio));
+        if (factor < 1 || std::fabs(ratio - static_cast<double>(factor)) > 1e-9 * ratio) {
+            return nullptr;
+        }
+
+        std::vector<std::size_t> best;
+        double best_cost = 0.0;
+        auto consider = [&](const std::vector<std::size_t>& factors) {
+            double cost = decimation_cost(input_freq, factors, spec);
+            if (best.empty() || cost < best_cost || (cost == best_cost && factors.size() < best.size())) {
+                best = factors;
+                best_cost = cost;
+            }
+        };
+
+        std::vector<std::size_t> halfbands;
+        for (std::size_t rest = factor; ; rest /= 2) {
+            if (rest == 1) {
+                if (!halfbands.empty()) {
+                    consider(halfbands);
+                }
+                break;
+            }
+
+            std::vector<std::size_t> factors = halfbands;
+            factors.push_back(rest);
+            consider(factors);
+            for (std::size_t second = 2; second * second <= rest; second++) {
+                if (rest % second == 0) {
+                    factors = halfbands;
+                    factors.push_back(rest / second);
+                    factors.push_back(second);
+                    consider(factors);
+                }
+            }
+
+            if (rest % 2 != 0) {
+                break;
+            }
+            halfbands.push_back(2);
+        }
+
+        auto cascade = std::make_unique<Cascade<T>>(input_freq, cascade_name);
+        if (best.empty()) {
+            return cascade;
+        }
+
+        const double ripple = spec.pass_ripple / static_cast<double>(best.size());
+        const double gain = std::pow(10.0, ripple / 20.0);
+        const double ripple_atten = -20.0 * std::log10((gain - 1.0) / (gain + 1.0));
+        double freq = input_freq;
+        double macs = 0.0;
+
+        for (std::size_t stage_factor : best) {
+            const double output_freq = freq / static_cast<double>(stage_factor);
+            std::vector<T> coeff = stage_factor == 2
+                ? halfband_coeff<T>(freq, output_freq - 2.0 * spec.freq_pass, std::max(spec.stop_atten, ripple_atten))
+                : kaiser_lowpass_coeff<T>(freq, FIR_Spec{spec.freq_pass, output_freq - spec.freq_pass, ripple, spec.stop_atten});
+            if (coeff.empty()) {
+                return nullptr;
+            }
+
+            const int order = static_cast<int>(coeff.size()) - 1;
+            Decimator<T> decimator(freq, cascade_name + " /" + std::to_string(stage_factor), stage_factor, coeff);
+            macs += static_cast<double>(decimator.get_active_taps()) / static_cast<double>(stage_factor) * freq / input_freq;
+            if (plan) {
+                plan->stages.push_back({stage_factor, freq, order, decimator.get_active_taps(), stage_factor == 2});
+            }
+
+            cascade->add_filter(decimator);
+            freq = output_freq;
+        }
+
+        if (plan) {
+            plan->macs_per_input = macs;
+        }
+        return cascade;
+    }
+
+}
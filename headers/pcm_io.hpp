@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+namespace af{
+
+    /**
+     * @brief Sample formats of interleaved PCM data (little endian).
+     */
+    enum class PCM_Format { Int16, Int24, Float32 };
+
+    /**
+     * @brief Description of PCM stream: format, interleaved channels and position of sample data in file.
+     */
+    struct PCM_Info {
+        PCM_Format format = PCM_Format::Int16;
+        int channels = 1;
+        double sampling_freq = 44100.0;
+        std::size_t data_offset = 0;
+        std::size_t frames = 0;
+    };
+
+    /**
+     * @brief Getter of size of one sample of given format.
+     * @return Returns number of bytes per sample (one channel).
+     */
+    inline std::size_t pcm_sample_size(PCM_Format format) {
+        switch (format) {
+            case PCM_Format::Int16:
+                return 2;
+            case PCM_Format::Int24:
+                return 3;
+            default:
+                return 4;
+        }
+    }
+
+    /**
+     * @brief Parses name of raw format ("s16", "s24", "f32").
+     * @return Returns true if name is known.
+     */
+    inline bool parse_pcm_format(const std::string& name, PCM_Format& format) {
+        if (name == "s16") {
+            format = PCM_Format::Int16;
+        }
+        else if (name == "s24") {
+            format = PCM_Format::Int24;
+        }
+        else if (name == "f32") {
+            format = PCM_Format::Float32;
+        }
+        else {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Helper reading little endian unsigned integer of given number of bytes.
+     */
+    inline std::uint32_t pcm_read_le(const unsigned char* data, int bytes) {
+        std::uint32_t value = 0;
+        for (int i = bytes - 1; i >= 0; i--) {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    /**
+     * @brief Parses RIFF/WAVE header (PCM 16/24 bit, IEEE float 32 bit, also WAVE_FORMAT_EXTENSIBLE).
+     * * Data chunk with size 0 or 0xFFFFFFFF (streamed files) or larger than file uses rest of the file.
+     * @param data Pointer to start of file.
+     * @param size Size of file in bytes.
+     * @param info Filled with format of file and position of sample data.
+     * @return Returns false if file is not supported WAV.
+     */
+    inline bool parse_wav_header(const unsigned char* data, std::size_t size, PCM_Info& info) {
+        if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+            return false;
+        }
+
+        bool has_format = false;
+        std::size_t position = 12;
+
+        while (position + 8 <= size) {
+            const unsigned char* chunk = data + position;
+            std::size_t chunk_size = pcm_read_le(chunk + 4, 4);
+            position += 8;
+
+            if (std::memcmp(chunk, "fmt ", 4) == 0) {
+                if (chunk_size < 16 || position + 16 > size) {
+                    return false;
+                }
+
+                std::uint32_t tag = pcm_read_le(chunk + 8, 2);
+                std::uint32_t bits = pcm_read_le(chunk + 22, 2);
+                if (tag == 0xFFFE && chunk_size >= 40 && position + 40 <= size) {
+                    tag = pcm_read_le(chunk + 32, 2);
+                }
+
+                info.channels = static_cast<int>(pcm_read_le(chunk + 10, 2));
+                info.sampling_freq = static_cast<double>(pcm_read_le(chunk + 12, 4));
+
+                if (tag == 1 && bits == 16) {
+                    info.format = PCM_Format::Int16;
+                }
+                else if (tag == 1 && bits == 24) {
+                    info.format = PCM_Format::Int24;
+                }
+                else if (tag == 3 && bits == 32) {
+                    info.format = PCM_Format::Float32;
+                }
+                else {
+                    return false;
+                }
+                has_format = info.channels > 0 && info.sampling_freq > 0;
+            }
+            else if (std::memcmp(chunk, "data", 4) == 0) {
+                if (!has_format) {
+                    return false;
+                }
+
+                if (chunk_size == 0 || chunk_size == 0xFFFFFFFFu || chunk_size > size - position) {
+                    chunk_size = size - position;
+                }
+
+                info.data_offset = position;
+                info.frames = chunk_size / (pcm_sample_size(info.format) * info.channels);
+                return true;
+            }
+
+            position += chunk_size + (chunk_size & 1);
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Converts one channel of interleaved PCM block to samples in range [-1, 1).
+     * @param input Pointer to first frame of interleaved PCM data.
+     * @param format Format of PCM data.
+     * @param channels Number of interleaved channels.
+     * @param channel Index of converted channel.
+     * @param output Pointer to at least frames samples.
+     * @param frames Number of frames.
+     */
+    template <typename T>
+    void pcm_decode(const unsigned char* input, PCM_Format format, int channels, int channel, T* output, std::size_t frames) {
+        const std::size_t sample_size = pcm_sample_size(format);
+        const std::size_t stride = sample_size * static_cast<std::size_t>(channels);
+        const unsigned char* position = input + sample_size * static_cast<std::size_t>(channel);
+
+        switch (format) {
+            case PCM_Format::Int16:
+                for (std::size_t i = 0; i < frames; i++, position += stride) {
+                    std::int16_t value = static_cast<std::int16_t>(position[0] | (position[1] << 8));
+                    output[i] = static_cast<T>(value) * static_cast<T>(1.0 / 32768.0);
+                }
+                break;
+            case PCM_Format::Int24:
+                for (std::size_t i = 0; i < frames; i++, position += stride) {
+                    std::int32_t value = static_cast<std::int32_t>(static_cast<std::uint32_t>(position[0] << 8 | position[1] << 16 | position[2] << 24)) >> 8;
+                    output[i] = static_cast<T>(value) * static_cast<T>(1.0 / 8388608.0);
+                }
+                break;
+            case PCM_Format::Float32:
+                for (std::size_t i = 0; i < frames; i++, position += stride) {
+                    float value;
+                    std::memcpy(&value, position, sizeof(value));
+                    output[i] = static_cast<T>(value);
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief TPDF_Dither generates triangular dither of +-1 LSB added before rounding to integer PCM (xorshift generator, no allocation).
+     * * Every channel should have own generator, so dither of channels is not correlated.
+     */
+    class TPDF_Dither {
+        private:
+            std::uint32_t m_state;
+
+        public:
+            explicit TPDF_Dither(std::uint32_t seed = 0x9E3779B9u) : m_state(seed ? seed : 1u) {}
+
+            /**
+             * @brief Next value of dither.
+             * @return Returns value in range (-1, 1) with triangular distribution (in LSB).
+             */
+            double next() {
+                m_state ^= m_state << 13;
+                m_state ^= m_state >> 17;
+                m_state ^= m_state << 5;
+                return (static_cast<double>(m_state & 0xFFFFu) - static_cast<double>(m_state >> 16)) * (1.0 / 65536.0);
+            }
+    };
+
+    /**
+     * @brief Converts samples to one channel of interleaved PCM block. Integer formats are rounded (with optional dither) and clipped.
+     * @param input Pointer to frames samples.
+     * @param output Pointer to first frame of interleaved PCM data.
+     * @param format Format of PCM data.
+     * @param channels Number of interleaved channels.
+     * @param channel Index of converted channel.
+     * @param frames Number of frames.
+     * @param dither Optional TPDF dither for integer formats (nullptr for plain rounding).
+     */
+    template <typename T>
+    void pcm_encode(const T* input, unsigned char* output, PCM_Format format, int channels, int channel, std::size_t frames, TPDF_Dither* dither = nullptr) {
+        const std::size_t sample_size = pcm_sample_size(format);
+        const std::size_t stride = sample_size * static_cast<std::size_t>(channels);
+        unsigned char* position = output + sample_size * static_cast<std::size_t>(channel);
+
+        if (format == PCM_Format::Float32) {
+            for (std::size_t i = 0; i < frames; i++, position += stride) {
+                float value = static_cast<float>(input[i]);
+                std::memcpy(position, &value, sizeof(value));
+            }
+            return;
+        }
+
+        const double scale = format == PCM_Format::Int16 ? 32768.0 : 8388608.0;
+        for (std::size_t i = 0; i < frames; i++, position += stride) {
+            double scaled = static_cast<double>(input[i]) * scale + (dither ? dither->next() : 0.0);
+            scaled = scaled < -scale ? -scale : (scaled > scale - 1.0 ? scale - 1.0 : scaled);
+            std::int32_t value = static_cast<std::int32_t>(scaled + (scaled < 0.0 ? -0.5 : 0.5));
+            position[0] = static_cast<unsigned char>(value);
+            position[1] = static_cast<unsigned char>(value >> 8);
+            if (format == PCM_Format::Int24) {
+                position[2] = static_cast<unsigned char>(value >> 16);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "fir_design.hpp"
+
+namespace af{
+
+    /**
+     * @brief Band of Parks-McClellan design, frequencies in Hz (see remez_coeff()).
+     * * Error in band is multiplied by weight, so band with bigger weight gets proportionally smaller ripple.
+     */
+    struct Remez_Band {
+        double freq_begin;
+        double freq_end;
+        double gain;
+        double weight;
+    };
+
+    /**
+     * @brief Result of Remez exchange returned by remez_coeff().
+     */
+    struct Remez_Report {
+        bool converged = false;
+        int iterations = 0;
+        double deviation = 0.0;     // weighted equiripple error
+    };
+
+    /**
+     * @brief Parks-McClellan (Remez exchange) design of linear phase FIR filter with equiripple weighted error.
+     * * Response is approximated on grid of 16 points per coeffitient, extremal frequencies are exchanged until
+     * * ripple is equal (relative difference below 1e-4) or 64 iterations pass. Interpolation uses barycentric
+     * * Lagrange form, so one iteration costs O(grid * order) and order of a few hundred is designed in milliseconds.
+     * * Odd order (even number of taps) has zero at fs/2, so highpass and bandstop need even order.
+     * @tparam T is type of numerical data of coeffitients.
+     * @param sampling_freq Double type sampling frequency.
+     * @param order Integer type order of filter (number of taps - 1), at most FIR_MAX_ORDER.
+     * @param bands Bands in increasing and not overlapping order, inside [0, sampling_freq / 2], weights positive.
+     * @param report Optional pointer filled with convergence, number of iterations and weighted deviation.
+     * @return Returns coeffitients (order + 1 taps). Empty if parameters are invalid.
+     */
+    template <typename T>
+    std::vector<T> remez_coeff(double sampling_freq, int order, const std::vector<Remez_Band>& bands, Remez_Report* report = nullptr) {
+        const int MAX_ITERATIONS = 64;
+        const double DENSITY = 16.0;
+
+        if (report) {
+            *report = Remez_Report();
+        }
+        if (order < 1 || order > FIR_MAX_ORDER || sampling_freq <= 0.0 || bands.empty()) {
+            return {};
+        }
+
+        double previous_end = 0.0;
+        for (std::size_t b = 0; b < bands.size(); b++) {
+            const Remez_Band& band = bands[b];
+            if (band.freq_begin < previous_end || (b > 0 && band.freq_begin == previous_end) || band.freq_end <= band.freq_begin
+                || 2.0 * band.freq_end > sampling_freq || band.weight <= 0.0) {
+                return {};
+            }
+            previous_end = band.freq_end;
+        }
+
+        const int taps = order + 1;
+        const bool odd_taps = taps % 2 == 1;
+        const int r = odd_taps ? (taps + 1) / 2 : taps / 2;     // number of cosine terms, r + 1 extremal frequencies
+
+        // dense grid: normalized frequency (0 - 0.5), x = cos(2 pi f), desired response and weight
+        std::vector<double> grid_x, desired, weight;
+        const double step = 0.5 / (DENSITY * r);
+        for (const Remez_Band& band : bands) {
+            double begin = band.freq_begin / sampling_freq;
+            double end = band.freq_end / sampling_freq;
+            int count = std::max(1, static_cast<int>(std::ceil((end - begin) / step)));
+
+            for (int i = 0; i <= count; i++) {
+                double freq = begin + (end - begin) * static_cast<double>(i) / static_cast<double>(count);
+                double gain = band.gain;
+                double band_weight = band.weight;
+
+                // even number of taps: H(f) = cos(pi f) P(f), P is approximated instead
+                if (!odd_taps) {
+                    double c = std::cos(M_PI * freq);
+                    if (c < 1e-6) {
+                        continue;
+                    }
+                    gain /= c;
+                    band_weight *= c;
+                }
+
+                grid_x.push_back(std::cos(2.0 * M_PI * freq));
+                desired.push_back(gain);
+                weight.push_back(band_weight);
+            }
+        }
+
+        const std::size_t grid_size = grid_x.size();
+        if (grid_size < static_cast<std::size_t>(r + 1)) {
+            return {};
+        }
+
+        std::vector<std::size_t> ext(r + 1);
+        for (int i = 0; i <= r; i++) {
+            ext[i] = static_cast<std::size_t>(i) * (grid_size - 1) / static_cast<std::size_t>(r);
+        }
+
+        std::vector<double> x(r + 1), ad(r + 1), log_weight(r + 1), y(r + 1), error(grid_size);
+        std::vector<std::size_t> found;
+        found.reserve(grid_size);
+        double delta = 0.0;
+
+        // barycentric Lagrange interpolation through (x, y)
+        auto interpolate = [&](double value) {
+            double num = 0.0, den = 0.0;
+            for (int i = 0; i <= r; i++) {
+                double diff = value - x[i];
+                if (std::fabs(diff) < 1e-14) {
+                    return y[i];
+                }
+                diff = ad[i] / diff;
+                num += diff * y[i];
+                den += diff;
+            }
+            return num / den;
+        };
+
+        int iteration = 0;
+        bool converged = false;
+        while (iteration < MAX_ITERATIONS) {
+            iteration++;
+
+            for (int i = 0; i <= r; i++) {
+                x[i] = grid_x[ext[i]];
+            }
+
+            // weights 1 / prod(x_i - x_k) in log domain, scaled by common factor (cancels in delta and interpolation)
+            double max_log = -HUGE_VAL;
+            for (int i = 0; i <= r; i++) {
+                double log_sum = 0.0;
+                bool negative = false;
+                for (int k = 0; k <= r; k++) {
+                    if (k != i) {
+                        double diff = x[i] - x[k];
+                        log_sum -= std::log(std::max(std::fabs(diff), 1e-300));
+                        negative ^= diff < 0.0;
+                    }
+                }
+                log_weight[i] = log_sum;
+                ad[i] = negative ? -1.0 : 1.0;
+                max_log = std::max(max_log, log_sum);
+            }
+            for (int i = 0; i <= r; i++) {
+                ad[i] *= std::exp(log_weight[i] - max_log);
+            }
+
+            double num = 0.0, den = 0.0, sign = 1.0;
+            for (int i = 0; i <= r; i++) {
+                num += ad[i] * desired[ext[i]];
+                den += sign * ad[i] / weight[ext[i]];
+                sign = -sign;
+            }
+            delta = num / den;
+
+            sign = 1.0;
+            for (int i = 0; i <= r; i++) {
+                y[i] = desired[ext[i]] - sign * delta / weight[ext[i]];
+                sign = -sign;
+            }
+
+            for (std::size_t j = 0; j < grid_size; j++) {
+                error[j] = weight[j] * (desired[j] - interpolate(grid_x[j]));
+            }
+
+            // local extrema of error
+            found.clear();
+            if ((error[0] > 0.0 && error[0] > error[1]) || (error[0] < 0.0 && error[0] < error[1])) {
+                found.push_back(0);
+            }
+            for (std::size_t j = 1; j + 1 < grid_size; j++) {
+                if ((error[j] >= error[j - 1] && error[j] > error[j + 1] && error[j] > 0.0)
+                    || (error[j] <= error[j - 1] && error[j] < error[j + 1] && error[j] < 0.0)) {
+                    found.push_back(j);
+                }
+            }
+            const std::size_t last = grid_size - 1;
+            if ((error[last] > 0.0 && error[last] > error[last - 1]) || (error[last] < 0.0 && error[last] < error[last - 1])) {
+                found.push_back(last);
+            }
+
+            // keep r + 1 alternating extrema: drop smaller of neighbours with the same sign, then smaller end point
+            while (found.size() > static_cast<std::size_t>(r + 1)) {
+                std::size_t remove = 0;
+                bool alternating = true;
+                for (std::size_t j = 1; j < found.size(); j++) {
+                    if ((error[found[j]] > 0.0) == (error[found[j - 1]] > 0.0)) {
+                        remove = std::fabs(error[found[j]]) < std::fabs(error[found[j - 1]]) ? j : j - 1;
+                        alternating = false;
+                        break;
+                    }
+                }
+                if (alternating) {
+                    remove = std::fabs(error[found.back()]) < std::fabs(error[found.front()]) ? found.size() - 1 : 0;
+                }
+                found.erase(found.begin() + static_cast<std::ptrdiff_t>(remove));
+            }
+
+            if (found.size() < static_cast<std::size_t>(r + 1)) {
+                break;
+            }
+            ext.assign(found.begin(), found.end());
+
+            double max_error = 0.0, min_error = HUGE_VAL;
+            for (std::size_t index : ext) {
+                double value = std::fabs(error[index]);
+                max_error = std::max(max_error, value);
+                min_error = std::min(min_error, value);
+            }
+            if (max_error > 0.0 && (max_error - min_error) / max_error < 1e-4) {
+                converged = true;
+                break;
+            }
+        }
+
+        // frequency sampling of final response at f = k / taps, inverse DFT of real symmetric amplitude
+        const int half = odd_taps ? (taps - 1) / 2 : taps / 2 - 1;
+        std::vector<double> amplitude(half + 1);
+        for (int k = 0; k <= half; k++) {
+            double freq = static_cast<double>(k) / static_cast<double>(taps);
+            amplitude[k] = interpolate(std::cos(2.0 * M_PI * freq));
+            if (!odd_taps) {
+                amplitude[k] *= std::cos(M_PI * freq);
+            }
+        }
+
+        std::vector<T> coeff(taps);
+        const double center = 0.5 * static_cast<double>(taps - 1);
+        for (int n = 0; n <= (taps - 1) / 2; n++) {
+            double sum = amplitude[0];
+            for (int k = 1; k <= half; k++) {
+                sum += 2.0 * amplitude[k] * std::cos(2.0 * M_PI * (static_cast<double>(n) - center) * static_cast<double>(k) / static_cast<double>(taps));
+            }
+            coeff[n] = static_cast<T>(sum / static_cast<double>(taps));
+            coeff[taps - 1 - n] = coeff[n];
+        }
+
+        if (report) {
+            report->converged = converged;
+            report->iterations = iteration;
+            report->deviation = std::fabs(delta);
+        }
+        return coeff;
+    }
+
+    /**
+     * @brief Equiripple design with minimal order meeting the specification (see remez_coeff()).
+     * * Stop bands get weight delta_pass / delta_stop. Kaiser's estimate for equiripple filters is corrected
+     * * by fir_min_order() with fir_meets_spec() check. Specification needing more than FIR_MAX_ORDER is rejected
+     * * without design, so tight specifications cannot stall startup.
+     * @param sampling_freq Double type sampling frequency.
+     * @param bands Pass and stop bands of specification (pass bands have gain 1, stop bands 0).
+     * @param transition Width of the narrowest transition band in Hz.
+     * @param pass_ripple Peak-to-peak passband ripple in dB.
+     * @param stop_atten Minimal stopband attenuation in dB.
+     * @param even_order True if order has to be even (highpass, bandstop).
+     * @return Returns coeffitients (order is size - 1). Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> remez_design_coeff(double sampling_freq, const std::vector<FIR_Spec_Band>& bands, double transition, double pass_ripple, double stop_atten, bool even_order) {
+        if (sampling_freq <= 0.0 || transition <= 0.0 || pass_ripple <= 0.0 || stop_atten <= 0.0) {
+            return {};
+        }
+
+        const double gain = std::pow(10.0, pass_ripple / 20.0);
+        const double delta_pass = (gain - 1.0) / (gain + 1.0);
+        const double delta_stop = std::pow(10.0, -stop_atten / 20.0);
+
+        std::vector<Remez_Band> remez_bands;
+        for (const FIR_Spec_Band& band : bands) {
+            remez_bands.push_back({band.freq_begin, band.freq_end, band.pass ? 1.0 : 0.0, band.pass ? 1.0 : delta_pass / delta_stop});
+        }
+
+        auto design = [&](int order) {
+            return remez_coeff<T>(sampling_freq, order, remez_bands);
+        };
+        auto meets = [&](const std::vector<T>& coeff) {
+            return !coeff.empty() && fir_meets_spec(coeff, sampling_freq, bands, delta_pass, delta_stop);
+        };
+
+        const int step = even_order ? 2 : 1;
+        double estimate = (-20.0 * std::log10(std::sqrt(delta_pass * delta_stop)) - 13.0) / (14.6 * transition / sampling_freq);
+        if (!(estimate <= static_cast<double>(FIR_MAX_ORDER))) {
+            return {};
+        }
+        int order = std::max(static_cast<int>(std::ceil(estimate)), 2);
+        order += order % step;
+        return fir_min_order<T>(order, step, 2 * order + 64, design, meets);
+    }
+
+    /**
+     * @brief Equiripple FIR lowpass with minimal order meeting the specification (see remez_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, freq_pass < freq_stop < sampling_freq / 2.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> remez_lowpass_coeff(double sampling_freq, const FIR_Spec& spec) {
+        if (spec.freq_pass <= 0.0 || spec.freq_stop <= spec.freq_pass || 2.0 * spec.freq_stop >= sampling_freq) {
+            return {};
+        }
+
+        return remez_design_coeff<T>(sampling_freq, {{0.0, spec.freq_pass, true}, {spec.freq_stop, 0.5 * sampling_freq, false}},
+                                     spec.freq_stop - spec.freq_pass, spec.pass_ripple, spec.stop_atten, false);
+    }
+
+    /**
+     * @brief Equiripple FIR highpass with minimal (even) order meeting the specification (see remez_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, freq_stop < freq_pass < sampling_freq / 2.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> remez_highpass_coeff(double sampling_freq, const FIR_Spec& spec) {
+        if (spec.freq_stop <= 0.0 || spec.freq_pass <= spec.freq_stop || 2.0 * spec.freq_pass >= sampling_freq) {
+            return {};
+        }
+
+        return remez_design_coeff<T>(sampling_freq, {{0.0, spec.freq_stop, false}, {spec.freq_pass, 0.5 * sampling_freq, true}},
+                                     spec.freq_pass - spec.freq_stop, spec.pass_ripple, spec.stop_atten, true);
+    }
+
+    /**
+     * @brief Equiripple FIR bandpass with minimal order meeting the specification (see remez_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, see FIR_Band_Spec.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> remez_bandpass_coeff(double sampling_freq, const FIR_Band_Spec& spec) {
+        if (spec.freq_stop_low <= 0.0 || spec.freq_pass_low <= spec.freq_stop_low || spec.freq_pass_high <= spec.freq_pass_low
+            || spec.freq_stop_high <= spec.freq_pass_high || 2.0 * spec.freq_stop_high >= sampling_freq) {
+            return {};
+        }
+
+        return remez_design_coeff<T>(sampling_freq, {{0.0, spec.freq_stop_low, false}, {spec.freq_pass_low, spec.freq_pass_high, true}, {spec.freq_stop_high, 0.5 * sampling_freq, false}},
+                                     std::min(spec.freq_pass_low - spec.freq_stop_low, spec.freq_stop_high - spec.freq_pass_high), spec.pass_ripple, spec.stop_atten, false);
+    }
+
+    /**
+     * @brief Equiripple FIR bandstop with minimal (even) order meeting the specification (see remez_design_coeff()).
+     * @param sampling_freq Double type sampling frequency.
+     * @param spec Edges, ripple and attenuation, see FIR_Band_Spec.
+     * @return Returns coeffitients, order is size - 1. Empty if specification is invalid or no order up to about twice the estimate (at most FIR_MAX_ORDER) meets it.
+     */
+    template <typename T>
+    std::vector<T> remez_bandstop_coeff(double sampling_freq, const FIR_Band_Spec& spec) {
+        if (spec.freq_pass_low <= 0.0 || spec.freq_stop_low <= spec.freq_pass_low || spec.freq_stop_high <= spec.freq_stop_low
+            || spec.freq_pass_high <= spec.freq_stop_high || 2.0 * spec.freq_pass_high >= sampling_freq) {
+            return {};
+        }
+
+        return remez_design_coeff<T>(sampling_freq, {{0.0, spec.freq_pass_low, true}, {spec.freq_stop_low, spec.freq_stop_high, false}, {spec.freq_pass_high, 0.5 * sampling_freq, true}},
+                                     std::min(spec.freq_stop_low - spec.freq_pass_low, spec.freq_pass_high - spec.freq_stop_high), spec.pass_ripple, spec.stop_atten, true);
+    }
+
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include "fft.hpp"
+
+namespace af{
+
+    /**
+     * @brief Value of transfer function (or of its numerator / denominator) and group delay in samples at one frequency.
+     */
+    struct Point_Response {
+        std::complex<double> value;
+        double delay;
+    };
+
+    /**
+     * @brief Evaluates polynomial P(z) = sum c[n] z^-n at z = e^jw together with it's group delay.
+     * * Powers of z are rotated by complex multiplication, so no trigonometric call is made per coeffitient.
+     * @param coeff Pointer to coeffitients.
+     * @param size Number of coeffitients.
+     * @param omega Normalized frequency (2 pi f / fs).
+     * @param leading_one True for IIR denominator 1 + sum c[n] z^-(n+1) (a0 is not stored).
+     * @return Returns value and group delay (0 at zeros of polynomial).
+     */
+    template <typename T>
+    Point_Response poly_response(const T* coeff, std::size_t size, double omega, bool leading_one = false) {
+        const std::complex<double> step(std::cos(omega), -std::sin(omega));
+        std::complex<double> rotation = leading_one ? step : std::complex<double>(1.0);
+        std::complex<double> sum = leading_one ? std::complex<double>(1.0) : std::complex<double>(0.0);
+        std::complex<double> ramp(0.0);
+        double n = leading_one ? 1.0 : 0.0;
+
+        for (std::size_t i = 0; i < size; i++, n += 1.0) {
+            std::complex<double> term = static_cast<double>(coeff[i]) * rotation;
+            sum += term;
+            ramp += n * term;
+            rotation *= step;
+        }
+
+        double power = std::norm(sum);
+        return {sum, power > 0.0 ? (ramp * std::conj(sum)).real() / power : 0.0};
+    }
+
+    /**
+     * @brief Response of IIR filter B(z) / A(z), a0 = 1 is not stored (same layout as IIR::get_coeff_a()).
+     * @return Returns value of transfer function and group delay (delay of B minus delay of A).
+     */
+    template <typename T>
+    Point_Response iir_response(const T* coeff_b, std::size_t size_b, const T* coeff_a, std::size_t size_a, double omega) {
+        Point_Response b = poly_response(coeff_b, size_b, omega);
+        Point_Response a = poly_response(coeff_a, size_a, omega, true);
+        return {b.value / a.value, b.delay - a.delay};
+    }
+
+    /**
+     * @brief Latency of filter with arbitrary phase: group delay averaged over passband with weight |H|^2.
+     * * Passband are frequencies with magnitude within -3 dB of peak, found on uniform grid from 0 to fs/2.
+     * @param response Function returning Point_Response for normalized frequency.
+     * @param points Number of grid intervals.
+     * @return Returns latency in samples (0 if response is zero everywhere).
+     */
+    template <typename F>
+    double passband_latency(F response, std::size_t points = 512) {
+        double peak = 0.0;
+        for (std::size_t k = 0; k <= points; k++) {
+            peak = std::max(peak, std::abs(response(M_PI * static_cast<double>(k) / static_cast<double>(points)).value));
+        }
+
+        double sum = 0.0, weight = 0.0;
+        for (std::size_t k = 0; k <= points; k++) {
+            Point_Response point = response(M_PI * static_cast<double>(k) / static_cast<double>(points));
+            double magnitude = std::abs(point.value);
+            if (peak > 0.0 && magnitude >= peak * M_SQRT1_2) {
+                sum += magnitude * magnitude * point.delay;
+                weight += magnitude * magnitude;
+            }
+        }
+        return weight > 0.0 ? sum / weight : 0.0;
+    }
+
+    /**
+     * @brief Evaluates polynomial P(z) = sum c[n] z^-n at many frequencies at once.
+     * * Loop over coeffitients is outside, loop over chunk of 64 frequencies inside (structure of arrays), so compiler
+     * * can vectorize phasor rotation. Cost is O(size * count) without trigonometric calls per coeffitient.
+     * @param coeff Pointer to coeffitients.
+     * @param size Number of coeffitients.
+     * @param omega Pointer to normalized frequencies (2 pi f / fs).
+     * @param response Pointer to count values written.
+     * @param count Number of frequencies.
+     * @param leading_one True for IIR denominator 1 + sum c[n] z^-(n+1) (a0 is not stored).
+     */
+    template <typename T>
+    void poly_response_batch(const T* coeff, std::size_t size, const double* omega, std::complex<double>* response, std::size_t count, bool leading_one = false) {
+        const std::size_t CHUNK = 64;
+        double step_re[CHUNK], step_im[CHUNK], rot_re[CHUNK], rot_im[CHUNK], sum_re[CHUNK], sum_im[CHUNK];
+
+        for (std::size_t base = 0; base < count; base += CHUNK) {
+            const std::size_t width = std::min(CHUNK, count - base);
+
+            for (std::size_t d = 0; d < width; d++) {
+                step_re[d] = std::cos(omega[base + d]);
+                step_im[d] = -std::sin(omega[base + d]);
+                rot_re[d] = leading_one ? step_re[d] : 1.0;
+                rot_im[d] = leading_one ? step_im[d] : 0.0;
+                sum_re[d] = leading_one ? 1.0 : 0.0;
+                sum_im[d] = 0.0;
+            }
+
+            for (std::size_t n = 0; n < size; n++) {
+                const double c = static_cast<double>(coeff[n]);
+                for (std::size_t d = 0; d < width; d++) {
+                    sum_re[d] += c * rot_re[d];
+                    sum_im[d] += c * rot_im[d];
+                    double next = rot_re[d] * step_re[d] - rot_im[d] * step_im[d];
+                    rot_im[d] = rot_re[d] * step_im[d] + rot_im[d] * step_re[d];
+                    rot_re[d] = next;
+                }
+            }
+
+            for (std::size_t d = 0; d < width; d++) {
+                response[base + d] = std::complex<double>(sum_re[d], sum_im[d]);
+            }
+        }
+    }
+
+    /**
+     * @brief Evaluates polynomial P(z) = sum c[n] z^-n at n_points evenly spaced frequencies w_k = pi k / n_points.
+     * * For n_points power of two one FFT of size 2 n_points is used (longer polynomials are wrapped modulo FFT size,
+     * * which gives exact samples of the response), otherwise poly_response_batch().
+     * @param coeff Pointer to coeffitients.
+     * @param size Number of coeffitients.
+     * @param response Pointer to n_points values written.
+     * @param n_points Number of frequencies.
+     * @param leading_one True for IIR denominator 1 + sum c[n] z^-(n+1) (a0 is not stored).
+     */
+    template <typename T>
+    void poly_response_grid(const T* coeff, std::size_t size, std::complex<double>* response, std::size_t n_points, bool leading_one = false) {
+        if (n_points == 0) {
+            return;
+        }
+
+        const std::size_t length = 2 * n_points;
+        if ((n_points & (n_points - 1)) != 0) {
+            std::vector<double> omega(n_points);
+            for (std::size_t k = 0; k < n_points; k++) {
+                omega[k] = M_PI * static_cast<double>(k) / static_cast<double>(n_points);
+            }
+            poly_response_batch(coeff, size, omega.data(), response, n_points, leading_one);
+            return;
+        }
+
+        std::vector<std::complex<double>> data(length);
+        const std::size_t offset = leading_one ? 1 : 0;
+        if (leading_one) {
+            data[0] = 1.0;
+        }
+        for (std::size_t n = 0; n < size; n++) {
+            data[(n + offset) % length] += static_cast<double>(coeff[n]);
+        }
+
+        fft(data);
+        std::copy(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(n_points), response);
+    }
+
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+
+namespace af{
+
+    /**
+     * @brief Reaction of real-time checker to allocation or lock inside filter() / filter_block().
+     */
+    enum class RT_Check_Mode { Off, Report, Abort };
+
+    enum class RT_Violation { Allocation, Deallocation, Lock };
+
+    /**
+     * @brief One recorded violation with name of innermost filter running at that moment.
+     */
+    struct RT_Violation_Record {
+        RT_Violation kind;
+        char filter_name[64];
+    };
+
+    /**
+     * @brief RT_Check is debug mode flagging allocations and mutex locks in the hot path of filters.
+     * * With AF_RT_CHECK defined (in every translation unit), filter() and filter_block() of library filters
+     * * mark the calling thread as running the filter (see RT_Scope). Hooks of malloc/new and pthread_mutex_lock,
+     * * compiled into the program by defining AF_RT_CHECK_HOOKS in exactly one translation unit, call notify().
+     * * Violations are recorded (Report) or printed with filter name and the program is aborted (Abort).
+     * * Hooks of malloc family and mutexes need glibc / POSIX, on other platforms only operator new/delete is hooked.
+     */
+    class RT_Check {
+        private:
+            static const std::size_t MAX_RECORDS = 64;
+
+            struct Thread_State {
+                const char* filter = nullptr;
+                bool in_hook = false;
+            };
+
+            static std::atomic<int>& mode_value() {
+                static std::atomic<int> mode{static_cast<int>(RT_Check_Mode::Off)};
+                return mode;
+            }
+
+            static std::atomic<std::size_t>& count_value() {
+                static std::atomic<std::size_t> count{0};
+                return count;
+            }
+
+            static RT_Violation_Record* records() {
+                static RT_Violation_Record list[MAX_RECORDS];
+                return list;
+            }
+
+        public:
+
+            static Thread_State& thread_state() {
+                static thread_local Thread_State state;
+                return state;
+            }
+
+            /**
+             * @brief Setter of checker mode (Off by default).
+             * @param mode New mode.
+             */
+            static void set_mode(RT_Check_Mode mode) {
+                mode_value().store(static_cast<int>(mode));
+            }
+
+            static RT_Check_Mode get_mode() {
+                return static_cast<RT_Check_Mode>(mode_value().load(std::memory_order_relaxed));
+            }
+
+            /**
+             * @brief Getter of number of violations since last clear() (including those not kept as records).
+             */
+            static std::size_t violation_count() {
+                return count_value().load();
+            }
+
+            /**
+             * @brief Getter of recorded violation (first 64 violations are kept).
+             * @param index Index of violation, must be smaller than violation_count() and 64.
+             */
+            static const RT_Violation_Record& get_violation(std::size_t index) {
+                return records()[index];
+            }
+
+            static void clear() {
+                count_value().store(0);
+            }
+
+            /**
+             * @brief Name of filter running on calling thread.
+             * @return Returns name of innermost filter, nullptr outside of filters.
+             */
+            static const char* current_filter() {
+                return thread_state().filter;
+            }
+
+            /**
+             * @brief Called by hooks. Records violation if calling thread runs a filter, does not allocate.
+             * @param kind Kind of violation.
+             */
+            static void notify(RT_Violation kind) {
+                RT_Check_Mode mode = get_mode();
+                if (mode == RT_Check_Mode::Off) {
+                    return;
+                }
+
+                Thread_State& state = thread_state();
+                if (!state.filter || state.in_hook) {
+                    return;
+                }
+
+                state.in_hook = true;
+                std::size_t index = count_value().fetch_add(1);
+                if (index < MAX_RECORDS) {
+                    records()[index].kind = kind;
+                    std::strncpy(records()[index].filter_name, state.filter, sizeof(records()[index].filter_name) - 1);
+                    records()[index].filter_name[sizeof(records()[index].filter_name) - 1] = '\0';
+                }
+
+                if (mode == RT_Check_Mode::Abort) {
+                    std::fputs("af::RT_Check: ", stderr);
+                    std::fputs(kind_name(kind), stderr);
+                    std::fputs(" inside filter '", stderr);
+                    std::fputs(state.filter, stderr);
+                    std::fputs("'\n", stderr);
+                    std::abort();
+                }
+                state.in_hook = false;
+            }
+
+            static const char* kind_name(RT_Violation kind) {
+                switch (kind) {
+                    case RT_Violation::Allocation:
+                        return "allocation";
+                    case RT_Violation::Deallocation:
+                        return "deallocation";
+                    default:
+                        return "mutex lock";
+                }
+            }
+    };
+
+    /**
+     * @brief RT_Scope marks calling thread as running filter of given name, restores previous filter on exit.
+     */
+    class RT_Scope {
+        private:
+            const char* m_previous;
+
+        public:
+            explicit RT_Scope(const char* filter_name) : m_previous(RT_Check::thread_state().filter) {
+                RT_Check::thread_state().filter = filter_name;
+            }
+
+            ~RT_Scope() {
+                RT_Check::thread_state().filter = m_previous;
+            }
+
+            RT_Scope(const RT_Scope&) = delete;
+            RT_Scope& operator=(const RT_Scope&) = delete;
+    };
+
+}
+
+/**
+ * @brief Used at the start of filter() / filter_block() of filters. Expands to nothing without AF_RT_CHECK.
+ */
+#ifdef AF_RT_CHECK
+#define AF_RT_SCOPE() af::RT_Scope af_rt_scope(this->filter_name_c_str())
+#else
+#define AF_RT_SCOPE()
+#endif
+
+#ifdef AF_RT_CHECK_HOOKS
+#include <new>
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+
+extern "C" {
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* pointer, std::size_t size);
+    void* __libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void* pointer);
+
+    void* malloc(std::size_t size) noexcept {
+        af::RT_Check::notify(af::RT_Violation::Allocation);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) noexcept {
+        af::RT_Check::notify(af::RT_Violation::Allocation);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, std::size_t size) noexcept {
+        af::RT_Check::notify(af::RT_Violation::Allocation);
+        return __libc_realloc(pointer, size);
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+        af::RT_Check::notify(af::RT_Violation::Allocation);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** pointer, std::size_t alignment, std::size_t size) noexcept {
+        af::RT_Check::notify(af::RT_Violation::Allocation);
+        *pointer = __libc_memalign(alignment, size);
+        return *pointer ? 0 : 12; // ENOMEM
+    }
+
+    void free(void* pointer) noexcept {
+        if (pointer) {
+            af::RT_Check::notify(af::RT_Violation::Deallocation);
+        }
+        __libc_free(pointer);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) {
+        using Lock_Function = int (*)(pthread_mutex_t*);
+        static std::atomic<Lock_Function> real{nullptr};
+
+        Lock_Function function = real.load(std::memory_order_acquire);
+        if (!function) {
+            function = reinterpret_cast<Lock_Function>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+            real.store(function, std::memory_order_release);
+        }
+
+        af::RT_Check::notify(af::RT_Violation::Lock);
+        return function(mutex);
+    }
+}
+
+#else
+
+void* operator new(std::size_t size) {
+    af::RT_Check::notify(af::RT_Violation::Allocation);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer) {
+        af::RT_Check::notify(af::RT_Violation::Deallocation);
+    }
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+#endif
+#endif
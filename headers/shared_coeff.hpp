@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace af{
+
+    /**
+     * @brief Shared_Coeff is immutable, reference counted storage of filter coeffitients.
+     * * Copies share the same memory, so clones of filters and filters made from cached designs don't copy coeffitients.
+     * * Storage is either owned vector or view of memory kept alive by other owner (for example mapped file).
+     * @tparam T is type of numerical data.
+     */
+    template <typename T>
+    class Shared_Coeff {
+        private:
+            std::shared_ptr<const T> m_data;
+            std::size_t m_size;
+
+        public:
+
+            /**
+             * @brief Default constructor - empty set of coeffitients.
+             */
+            Shared_Coeff() : m_size(0) {}
+
+            /**
+             * @brief Constructor taking ownership of vector of coeffitients.
+             * @param values Vector of coeffitients.
+             */
+            explicit Shared_Coeff(std::vector<T> values) : m_size(values.size()) {
+                auto owner = std::make_shared<const std::vector<T>>(std::move(values));
+                m_data = std::shared_ptr<const T>(owner, owner->data());
+            }
+
+            /**
+             * @brief Makes view of coeffitients stored outside, without copy.
+             * @param owner Shared pointer keeping memory of coeffitients alive.
+             * @param data Pointer to first coeffitient.
+             * @param size Number of coeffitients.
+             * @return Returns set of coeffitients sharing ownership with owner.
+             */
+            static Shared_Coeff view(const std::shared_ptr<const void>& owner, const T* data, std::size_t size) {
+                Shared_Coeff coeff;
+                coeff.m_data = std::shared_ptr<const T>(owner, data);
+                coeff.m_size = size;
+                return coeff;
+            }
+
+            /**
+             * @brief Getter of pointer to coeffitients.
+             * @return Returns pointer to first coeffitient.
+             */
+            const T* data() const {
+                return m_data.get();
+            }
+
+            /**
+             * @brief Getter of number of coeffitients.
+             * @return Returns number of coeffitients.
+             */
+            std::size_t size() const {
+                return m_size;
+            }
+
+            /**
+             * @brief Checks if set of coeffitients is empty.
+             * @return Returns true if there are no coeffitients.
+             */
+            bool empty() const {
+                return m_size == 0;
+            }
+
+            /**
+             * @brief Access to single coeffitient.
+             * @param i Index of coeffitient.
+             * @return Returns value of coeffitient.
+             */
+            const T& operator[](std::size_t i) const {
+                return m_data.get()[i];
+            }
+
+            const T* begin() const {
+                return m_data.get();
+            }
+
+            const T* end() const {
+                return m_data.get() + m_size;
+            }
+
+            /**
+             * @brief Checks if two sets share the same memory.
+             * @param other Other set of coeffitients.
+             * @return Returns true if both sets point to the same coeffitients.
+             */
+            bool shares_with(const Shared_Coeff& other) const {
+                return m_data == other.m_data && m_size == other.m_size;
+            }
+
+            /**
+             * @brief Conversion to vector (copy), kept for code using coeffitients as std::vector.
+             */
+            operator std::vector<T>() const {
+                return std::vector<T>(begin(), end());
+            }
+    };
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include "cycle_counter.hpp"
+
+namespace af{
+
+    /**
+     * @brief Counters of one stage of profiled Cascade (see Cascade::set_profiling()).
+     * * Time is in read_cycles() ticks, one call of filter() counts as block of 1 sample.
+     */
+    struct Stage_Profile {
+        std::string name;
+        std::uint64_t samples = 0;
+        std::uint64_t blocks = 0;
+        std::uint64_t cycles = 0;
+        std::uint64_t max_block_cycles = 0;
+        double peak = 0.0;
+        double sum_squares = 0.0;
+
+        /**
+         * @brief Adds one processed block to counters.
+         * @param output Pointer to output samples of stage.
+         * @param length Number of samples in block.
+         * @param block_cycles Time spent in stage.
+         */
+        template <typename T>
+        void record(const T* output, std::size_t length, std::uint64_t block_cycles) {
+            samples += length;
+            blocks++;
+            cycles += block_cycles;
+            if (block_cycles > max_block_cycles) {
+                max_block_cycles = block_cycles;
+            }
+
+            for (std::size_t i = 0; i < length; i++) {
+                double value = static_cast<double>(output[i]);
+                double magnitude = std::fabs(value);
+                if (magnitude > peak) {
+                    peak = magnitude;
+                }
+                sum_squares += value * value;
+            }
+        }
+
+        /**
+         * @brief Getter of RMS of stage output.
+         * @return Returns RMS of all processed output samples (0 if no samples).
+         */
+        double rms() const {
+            return samples ? std::sqrt(sum_squares / static_cast<double>(samples)) : 0.0;
+        }
+
+        /**
+         * @brief Getter of mean time per sample.
+         * @return Returns nanoseconds per sample (0 if no samples).
+         */
+        double ns_per_sample() const {
+            return samples ? static_cast<double>(cycles) / cycles_per_ns() / static_cast<double>(samples) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Formats profile of cascade as text table (one row per stage).
+     * @param profile Counters returned by Cascade::get_profile().
+     * @return Returns table as string.
+     */
+    inline std::string profile_table(const std::vector<Stage_Profile>& profile) {
+        std::ostringstream out;
+        out << std::left << std::setw(4) << "#" << std::setw(20) << "stage" << std::right << std::setw(12) << "samples"
+            << std::setw(12) << "total ms" << std::setw(10) << "ns/sample" << std::setw(8) << "share" << std::setw(14) << "max block us"
+            << std::setw(12) << "peak" << std::setw(12) << "rms" << "\n";
+
+        std::uint64_t total = 0;
+        for (const Stage_Profile& stage : profile) {
+            total += stage.cycles;
+        }
+
+        const double ratio = cycles_per_ns();
+        out << std::setprecision(4);
+        for (std::size_t i = 0; i < profile.size(); i++) {
+            const Stage_Profile& stage = profile[i];
+            double share = total ? 100.0 * static_cast<double>(stage.cycles) / static_cast<double>(total) : 0.0;
+            out << std::left << std::setw(4) << i << std::setw(20) << stage.name << std::right << std::setw(12) << stage.samples
+                << std::setw(12) << static_cast<double>(stage.cycles) / ratio * 1e-6 << std::setw(10) << stage.ns_per_sample()
+                << std::setw(7) << share << "%" << std::setw(14) << static_cast<double>(stage.max_block_cycles) / ratio * 1e-3
+                << std::setw(12) << stage.peak << std::setw(12) << stage.rms() << "\n";
+        }
+
+        return out.str();
+    }
+
+    /**
+     * @brief Formats profile of cascade as JSON array (one object per stage, times in nanoseconds).
+     * @param profile Counters returned by Cascade::get_profile().
+     * @return Returns JSON as string.
+     */
+    inline std::string profile_json(const std::vector<Stage_Profile>& profile) {
+        std::ostringstream out;
+        const double ratio = cycles_per_ns();
+        out << std::setprecision(8) << "[";
+
+        for (std::size_t i = 0; i < profile.size(); i++) {
+            const Stage_Profile& stage = profile[i];
+            std::string name;
+            for (char c : stage.name) {
+                if (c == '"' || c == '\\') {
+                    name += '\\';
+                }
+                name += c;
+            }
+
+            out << (i ? ",\n " : "\n ") << "{\"stage\": " << i << ", \"name\": \"" << name << "\", \"samples\": " << stage.samples
+                << ", \"blocks\": " << stage.blocks << ", \"total_ns\": " << static_cast<double>(stage.cycles) / ratio
+                << ", \"ns_per_sample\": " << stage.ns_per_sample() << ", \"max_block_ns\": " << static_cast<double>(stage.max_block_cycles) / ratio
+                << ", \"peak\": " << stage.peak << ", \"rms\": " << stage.rms() << "}";
+        }
+
+        out << "\n]\n";
+        return out.str();
+    }
+
+}
@@ -0,0 +1,873 @@
+#include "headers/base_filter.hpp"
+#include "headers/filter_type.hpp"
+#include "headers/FIRs.hpp"
+#include "headers/IIRs.hpp"
+#include "headers/SVFs.hpp"
+#include "headers/filter_cascade.hpp"
+#include "headers/multirate.hpp"
+#include "headers/cycle_counter.hpp"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+
+namespace {
+
+    const std::size_t BLOCK = 256;
+
+    /**
+     * @brief One row of benchmark report. Unit is the thing measured per iteration (sample, design or block).
+     */
+    struct Result {
+        std::string group;
+        std::string name;
+        std::string type;
+        int order;
+        int depth;
+        std::string mode;
+        std::size_t block;
+        std::string unit;
+        double ns;
+        double cycles;
+    };
+
+    /**
+     * @brief Suite runs measurements, prints table rows and keeps results for JSON report.
+     * * Usage: dsp_bench [--json path] [--group name] [--quick]
+     */
+    class Suite {
+        private:
+            double m_min_seconds = 0.05;
+            std::string m_group;
+            std::string m_json_path;
+            std::vector<Result> m_results;
+            double m_sink = 0;
+
+        public:
+
+            Suite(int argc, char** argv) {
+                for (int i = 1; i < argc; i++) {
+                    std::string arg = argv[i];
+                    if (arg == "--json" && i + 1 < argc) {
+                        m_json_path = argv[++i];
+                    }
+                    else if (arg == "--group" && i + 1 < argc) {
+                        m_group = argv[++i];
+                    }
+                    else if (arg == "--quick") {
+                        m_min_seconds = 0.005;
+                    }
+                }
+            }
+
+            /**
+             * @brief Checks if group of benchmarks was selected (all groups run by default).
+             */
+            bool enabled(const std::string& group) const {
+                return m_group.empty() || m_group == group;
+            }
+
+            /**
+             * @brief Keeps value computed by benchmark, so compiler cannot remove measured work.
+             */
+            void sink(double value) {
+                m_sink += value;
+            }
+
+            /**
+             * @brief Runs function repeatedly (doubling count) until it takes at least minimal time.
+             * @param run Function doing work for units_per_run units.
+             * @param units_per_run Number of measured units (samples, designs, blocks) in one call.
+             * @return Returns pair of nanoseconds and cycles per unit.
+             */
+            template <typename F>
+            std::pair<double, double> measure(F&& run, std::size_t units_per_run) {
+                run();
+
+                for (std::size_t count = 1; ; count *= 2) {
+                    auto start = std::chrono::steady_clock::now();
+                    std::uint64_t c_start = af::read_cycles();
+                    for (std::size_t i = 0; i < count; i++) {
+                        run();
+                    }
+                    std::uint64_t c_stop = af::read_cycles();
+                    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+                    if (ns >= m_min_seconds * 1e9 || count >= (std::size_t(1) << 40)) {
+                        double units = static_cast<double>(count) * static_cast<double>(units_per_run);
+                        return {ns / units, static_cast<double>(c_stop - c_start) / units};
+                    }
+                }
+            }
+
+            /**
+             * @brief Stores and prints one result.
+             */
+            void add(const Result& result) {
+                m_results.push_back(result);
+                std::cout << std::left << std::setw(9) << result.group << std::setw(22) << result.name << std::setw(7) << result.type
+                          << std::right << std::setw(6) << result.order << std::setw(4) << result.depth << "  " << std::left << std::setw(16) << result.mode
+                          << std::right << std::setw(6) << result.block << std::setw(12) << std::setprecision(4) << result.ns
+                          << std::setw(12) << 1e3 / result.ns << std::setw(12) << result.cycles << "  " << result.unit << std::endl;
+            }
+
+            /**
+             * @brief Prints header of result table.
+             */
+            void print_header() const {
+                std::cout << std::left << std::setw(9) << "group" << std::setw(22) << "name" << std::setw(7) << "type"
+                          << std::right << std::setw(6) << "order" << std::setw(4) << "dep" << "  " << std::left << std::setw(16) << "mode"
+                          << std::right << std::setw(6) << "block" << std::setw(12) << "ns/unit" << std::setw(12) << "Munit/s"
+                          << std::setw(12) << "cyc/unit" << "  unit" << std::endl;
+            }
+
+            /**
+             * @brief Writes all results to JSON file, if --json was given.
+             * @return Returns false if file could not be written.
+             */
+            bool write_json() const {
+                if (m_json_path.empty()) {
+                    return true;
+                }
+
+                std::ofstream out(m_json_path);
+                out << std::setprecision(8);
+                out << "{\n  \"benchmark\": \"dsp_bench\",\n  \"format_version\": 1,\n";
+#ifdef __VERSION__
+                out << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+                out << "  \"cycles_per_ns\": " << af::cycles_per_ns() << ",\n  \"results\": [\n";
+
+                for (std::size_t i = 0; i < m_results.size(); i++) {
+                    const Result& r = m_results[i];
+                    out << "    {\"group\": \"" << r.group << "\", \"name\": \"" << r.name << "\", \"type\": \"" << r.type
+                        << "\", \"order\": " << r.order << ", \"depth\": " << r.depth << ", \"mode\": \"" << r.mode
+                        << "\", \"block\": " << r.block << ", \"unit\": \"" << r.unit << "\", \"ns_per_unit\": " << r.ns
+                        << ", \"units_per_sec\": " << 1e9 / r.ns << ", \"cycles_per_unit\": " << r.cycles << "}"
+                        << (i + 1 < m_results.size() ? ",\n" : "\n");
+                }
+
+                out << "  ]\n}\n";
+                return static_cast<bool>(out);
+            }
+
+            double get_sink() const {
+                return m_sink;
+            }
+    };
+
+    template <typename T>
+    const char* type_name();
+
+    template <>
+    const char* type_name<float>() {
+        return "float";
+    }
+
+    template <>
+    const char* type_name<double>() {
+        return "double";
+    }
+
+    /**
+     * @brief Uniform noise used as input of benchmarks (keeps filters out of subnormal range).
+     */
+    template <typename T>
+    std::vector<T> noise(std::size_t length, unsigned seed = 1)
+    {
+        std::vector<T> samples(length);
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (T& s : samples) {
+            s = static_cast<T>(dist(gen));
+        }
+        return samples;
+    }
+
+    /**
+     * @brief Measures filter with per-sample filter() calls and with filter_block() calls.
+     */
+    template <typename T>
+    void bench_filter(Suite& suite, const std::string& group, const std::string& name, af::Base_Filter<T>& filter, int order, int depth, std::size_t block, bool per_sample = true)
+    {
+        std::vector<T> input = noise<T>(block);
+        std::vector<T> output(block);
+
+        if (per_sample) {
+            auto t = suite.measure([&] {
+                for (std::size_t i = 0; i < block; i++) {
+                    output[i] = filter.filter(input[i]);
+                }
+                suite.sink(static_cast<double>(output[0]));
+            }, block);
+            suite.add({group, name, type_name<T>(), order, depth, "sample", block, "sample", t.first, t.second});
+        }
+
+        auto t = suite.measure([&] {
+            filter.filter_block(input.data(), output.data(), block);
+            suite.sink(static_cast<double>(output[0]));
+        }, block);
+        suite.add({group, name, type_name<T>(), order, depth, "block", block, "sample", t.first, t.second});
+    }
+
+    /**
+     * @brief Arbitrary FIR for orders from 4 to 8192 and FIR/IIR block size sweep.
+     */
+    template <typename T>
+    void bench_fir(Suite& suite)
+    {
+        if (suite.enabled("fir")) {
+            for (int order : {4, 16, 64, 256, 1024, 4096, 8192}) {
+                std::vector<T> coeff = noise<T>(order + 1, 7);
+                af::FIR<T> filter(48000.0, "FIR", coeff);
+                bench_filter<T>(suite, "fir", "FIR", filter, order, 1, BLOCK);
+            }
+        }
+
+        if (suite.enabled("block")) {
+            for (std::size_t block : {1, 16, 64, 256, 1024, 4096}) {
+                af::FIR<T> fir(48000.0, "FIR", noise<T>(65, 7));
+                bench_filter<T>(suite, "block", "FIR", fir, 64, 1, block, false);
+                af::ChebyshevLowpass<T> iir(48000.0, "IIR", 2, 1000.0, 1.0);
+                bench_filter<T>(suite, "block", "ChebyshevLowpass", iir, 2, 1, block, false);
+            }
+        }
+    }
+
+    /**
+     * @brief Arbitrary IIR of increasing order (coeffitients a are small, so filter is stable).
+     */
+    template <typename T>
+    void bench_iir(Suite& suite)
+    {
+        if (!suite.enabled("iir")) {
+            return;
+        }
+
+        for (int order : {2, 4, 8, 16, 32}) {
+            std::vector<T> b = noise<T>(order + 1, 3);
+            std::vector<T> a = noise<T>(order, 5);
+            for (T& val : a) {
+                val *= static_cast<T>(0.5 / order);
+            }
+            af::IIR<T> filter(48000.0, "IIR", b, a);
+            bench_filter<T>(suite, "iir", "IIR", filter, order, 1, BLOCK);
+        }
+    }
+
+    /**
+     * @brief Every designed filter class of the library.
+     */
+    template <typename T>
+    void bench_designs(Suite& suite)
+    {
+        if (!suite.enabled("design")) {
+            return;
+        }
+
+        for (int order : {64, 256}) {
+            af::Lowpass<T> lowpass(48000.0, "Lowpass", order, 3000.0);
+            bench_filter<T>(suite, "design", "Lowpass", lowpass, order, 1, BLOCK);
+            af::Highpass<T> highpass(48000.0, "Highpass", order, 3000.0);
+            bench_filter<T>(suite, "design", "Highpass", highpass, order, 1, BLOCK);
+            af::Bandpass<T> bandpass(48000.0, "Bandpass", order, 300.0, 3000.0);
+            bench_filter<T>(suite, "design", "Bandpass", bandpass, order, 1, BLOCK);
+            af::Bandstop<T> bandstop(48000.0, "Bandstop", order, 300.0, 3000.0);
+            bench_filter<T>(suite, "design", "Bandstop", bandstop, order, 1, BLOCK);
+        }
+
+        // order chosen by specification (80 dB stopband, 1 kHz transition)
+        af::Lowpass<T> kaiser = af::kaiser_lowpass<T>(48000.0, "KaiserLowpass", af::FIR_Spec{2500.0, 3500.0, 0.1, 80.0});
+        bench_filter<T>(suite, "design", "KaiserLowpass", kaiser, kaiser.get_order(), 1, BLOCK);
+        af::Lowpass<T> remez = af::remez_lowpass<T>(48000.0, "RemezLowpass", af::FIR_Spec{2500.0, 3500.0, 0.1, 80.0});
+        bench_filter<T>(suite, "design", "RemezLowpass", remez, remez.get_order(), 1, BLOCK);
+        af::EllipticLowpass<T> elliptic(48000.0, "EllipticLowpass", af::IIR_Spec{2500.0, 3500.0, 0.1, 80.0});
+        bench_filter<T>(suite, "design", "EllipticLowpass", elliptic, elliptic.get_order(), 1, BLOCK);
+
+        af::ChebyshevLowpass<T> cheb_low(48000.0, "ChebyshevLowpass", 2, 3000.0, 1.0);
+        bench_filter<T>(suite, "design", "ChebyshevLowpass", cheb_low, 2, 1, BLOCK);
+        af::ChebyshevHighpass<T> cheb_high(48000.0, "ChebyshevHighpass", 2, 300.0, 1.0);
+        bench_filter<T>(suite, "design", "ChebyshevHighpass", cheb_high, 2, 1, BLOCK);
+        af::StateVariable<T> svf(48000.0, "StateVariable", af::SVF_Mode::Lowpass, 3000.0, 0.707);
+        bench_filter<T>(suite, "design", "StateVariable", svf, 2, 1, BLOCK);
+
+        std::vector<T> input = noise<T>(BLOCK);
+        std::vector<T> cutoff(BLOCK);
+        std::vector<T> output(BLOCK);
+        for (std::size_t i = 0; i < BLOCK; i++) {
+            cutoff[i] = static_cast<T>(1000.0 + 4000.0 * i / BLOCK);
+        }
+        auto t = suite.measure([&] {
+            svf.filter_block(input.data(), output.data(), cutoff.data(), BLOCK);
+            suite.sink(static_cast<double>(output[0]));
+        }, BLOCK);
+        suite.add({"design", "StateVariable", type_name<T>(), 2, 1, "block_modulated", BLOCK, "sample", t.first, t.second});
+    }
+
+    /**
+     * @brief Cascades of ChebyshevLowpass biquads of increasing depth.
+     */
+    template <typename T>
+    void bench_cascade(Suite& suite)
+    {
+        if (!suite.enabled("cascade")) {
+            return;
+        }
+
+        for (int depth : {1, 2, 4, 8, 16}) {
+            af::Cascade<T> cascade(48000.0, "Cascade");
+            for (int d = 0; d < depth; d++) {
+                cascade.add_filter(af::ChebyshevLowpass<T>(48000.0, "IIR LPF", 2, 3000.0 + 100.0 * d, 1.0));
+            }
+            bench_filter<T>(suite, "cascade", "Cascade", cascade, 2, depth, BLOCK);
+        }
+    }
+
+    /**
+     * @brief High order ChebyshevLowpass as fused SOS bank, as Cascade of IIR biquads with the same sections
+     * * and as one IIR with expanded polynomials (order 8 only, higher orders are not stable in float).
+     */
+    template <typename T>
+    void bench_sos(Suite& suite)
+    {
+        if (!suite.enabled("sos")) {
+            return;
+        }
+
+        for (int order : {4, 8, 16}) {
+            af::ChebyshevLowpass<T> bank(48000.0, "SOS", order, 3000.0, 1.0);
+            bench_filter<T>(suite, "sos", "SOS bank", bank, order, 1, BLOCK);
+
+            af::Cascade<T> cascade(48000.0, "Cascade");
+            const af::Shared_Coeff<T>& sections = bank.get_sections();
+            for (std::size_t s = 0; s < bank.get_section_count(); s++) {
+                const T* c = sections.data() + 5 * s;
+                cascade.add_filter(af::IIR<T>(48000.0, "biquad", std::vector<T>(c, c + 3), std::vector<T>(c + 3, c + 5)));
+            }
+            bench_filter<T>(suite, "sos", "Cascade biquads", cascade, order, static_cast<int>(bank.get_section_count()), BLOCK);
+
+            if (order <= 8) {
+                af::IIR<T> expanded(48000.0, "IIR", bank.get_coeff_b(), bank.get_coeff_a());
+                bench_filter<T>(suite, "sos", "IIR expanded", expanded, order, 1, BLOCK);
+            }
+        }
+    }
+
+    /**
+     * @brief Boxcar of growing length as FIR with equal taps, as recursive MovingAverage and as 3 stage CIC,
+     * * plus CIC decimating by 8 through process() (cost per input sample).
+     */
+    template <typename T>
+    void bench_average(Suite& suite)
+    {
+        if (!suite.enabled("average")) {
+            return;
+        }
+
+        for (int length : {16, 64, 256}) {
+            af::FIR<T> fir(48000.0, "FIR", std::vector<T>(length, static_cast<T>(1.0 / length)));
+            bench_filter<T>(suite, "average", "FIR equal taps", fir, length - 1, 1, BLOCK);
+
+            af::MovingAverage<T> average(48000.0, "MovingAverage", static_cast<std::size_t>(length));
+            bench_filter<T>(suite, "average", "MovingAverage", average, length - 1, 1, BLOCK);
+
+            af::CIC<T> cic(48000.0, "CIC", af::CIC_Mode::Decimator, 3, static_cast<std::size_t>(length));
+            bench_filter<T>(suite, "average", "CIC", cic, 3 * (length - 1), 3, BLOCK);
+        }
+
+        af::CIC<T> decimator(48000.0, "CIC", af::CIC_Mode::Decimator, 3, 8);
+        std::vector<T> input = noise<T>(BLOCK);
+        std::vector<T> output(BLOCK);
+        auto t = suite.measure([&] {
+            std::size_t count = decimator.process(input.data(), BLOCK, output.data());
+            suite.sink(static_cast<double>(output[0]) + static_cast<double>(count));
+        }, BLOCK);
+        suite.add({"average", "CIC decimate 8", type_name<T>(), 21, 3, "process", BLOCK, "sample", t.first, t.second});
+    }
+
+    /**
+     * @brief Zero skipping kernels: halfband lowpass and Hilbert transformer against FIR of the same length with dense taps.
+     */
+    template <typename T>
+    void bench_sparse(Suite& suite)
+    {
+        if (!suite.enabled("sparse")) {
+            return;
+        }
+
+        for (double transition : {4000.0, 1000.0, 250.0}) {
+            af::Lowpass<T> halfband = af::halfband_lowpass<T>(48000.0, "Halfband", transition, 80.0);
+            const int order = halfband.get_order();
+            bench_filter<T>(suite, "sparse", "Halfband", halfband, order, 1, BLOCK);
+
+            af::FIR<T> dense(48000.0, "FIR", noise<T>(static_cast<std::size_t>(order) + 1, 7));
+            bench_filter<T>(suite, "sparse", "FIR dense", dense, order, 1, BLOCK);
+
+            af::FIR<T> hilbert = af::hilbert<T>(48000.0, "Hilbert", 0.5 * transition, 60.0);
+            bench_filter<T>(suite, "sparse", "Hilbert", hilbert, static_cast<int>(hilbert.get_coeff().size()) - 1, 1, BLOCK);
+        }
+    }
+
+    /**
+     * @brief Decimation by 8 with passband 2400 Hz and 80 dB alias attenuation: single rate Kaiser lowpass filtering every sample,
+     * * one Decimator stage and multistage chain from decimation_chain() (cost per input sample of process()).
+     */
+    template <typename T>
+    void bench_multirate(Suite& suite)
+    {
+        if (!suite.enabled("decimate")) {
+            return;
+        }
+
+        const af::Decimation_Spec spec{2400.0, 6000.0, 0.1, 80.0};
+        std::vector<T> coeff = af::kaiser_lowpass_coeff<T>(48000.0, af::FIR_Spec{spec.freq_pass, spec.output_freq - spec.freq_pass, spec.pass_ripple, spec.stop_atten});
+        const int order = static_cast<int>(coeff.size()) - 1;
+
+        af::FIR<T> single(48000.0, "FIR", coeff);
+        bench_filter<T>(suite, "decimate", "FIR single rate", single, order, 1, BLOCK, false);
+
+        af::Decimator<T> decimator(48000.0, "Decimator", 8, coeff);
+        af::Decimation_Plan plan;
+        auto chain = af::decimation_chain<T>(48000.0, "Chain", spec, &plan);
+
+        std::vector<T> input = noise<T>(BLOCK);
+        std::vector<T> output(BLOCK);
+        auto run = [&](const std::string& name, af::Base_Filter<T>& filter, int stages) {
+            auto t = suite.measure([&] {
+                std::size_t count = filter.process(input.data(), BLOCK, output.data());
+                suite.sink(static_cast<double>(output[0]) + static_cast<double>(count));
+            }, BLOCK);
+            suite.add({"decimate", name, type_name<T>(), order, stages, "process", BLOCK, "sample", t.first, t.second});
+        };
+
+        run("Decimator /8", decimator, 1);
+        run("Chain /8 (" + std::to_string(plan.macs_per_input).substr(0, 5) + " MAC)", *chain, static_cast<int>(plan.stages.size()));
+    }
+
+    /**
+     * @brief Long cascades over large buffer: sample by sample through all stages, whole buffer through each stage in turn
+     * * and tiled filter_block() (automatic tile length).
+     */
+    void bench_tiled(Suite& suite)
+    {
+        if (!suite.enabled("tiled")) {
+            return;
+        }
+
+        const std::size_t length = std::size_t(1) << 20;
+        std::vector<float> input = noise<float>(length);
+        std::vector<float> output(length);
+
+        for (int depth : {8, 16}) {
+          for (bool svf : {false, true}) {
+            af::Cascade<float> cascade(48000.0, "Cascade");
+            for (int d = 0; d < depth; d++) {
+                if (svf) {
+                    cascade.add_filter(af::StateVariable<float>(48000.0, "SVF", af::SVF_Mode::Lowpass, 8000.0 + 100.0 * d, 0.707));
+                }
+                else if (d % 2 == 0) {
+                    cascade.add_filter(af::Lowpass<float>(48000.0, "FIR LPF", 32, 8000.0 + 100.0 * d));
+                }
+                else {
+                    cascade.add_filter(af::ChebyshevLowpass<float>(48000.0, "IIR LPF", 2, 8000.0 + 100.0 * d, 1.0));
+                }
+            }
+            const std::string name = svf ? "Cascade SVF" : "Cascade FIR/IIR";
+            const int order = svf ? 2 : 32;
+
+            auto t = suite.measure([&] {
+                for (std::size_t i = 0; i < length; i++) {
+                    output[i] = cascade.filter(input[i]);
+                }
+            }, length);
+            suite.add({"tiled", name, "float", order, depth, "sample_major", length, "sample", t.first, t.second});
+
+            cascade.set_tile_length(length);
+            t = suite.measure([&] {
+                cascade.filter_block(input.data(), output.data(), length);
+            }, length);
+            suite.add({"tiled", name, "float", order, depth, "stage_major", length, "sample", t.first, t.second});
+
+            cascade.set_tile_length(0);
+            t = suite.measure([&] {
+                cascade.filter_block(input.data(), output.data(), length);
+            }, length);
+            suite.add({"tiled", name, "float", order, depth, "tiled_" + std::to_string(cascade.get_tile_length()), length, "sample", t.first, t.second});
+          }
+        }
+    }
+
+    /**
+     * @brief Overhead of Cascade per-stage profiling. dsp_bench measures default Cascade (counters compiled out),
+     * * dsp_bench_profile (built with AF_CASCADE_PROFILING) measures them disabled and enabled at run time.
+     */
+    void bench_profiling(Suite& suite)
+    {
+        if (!suite.enabled("profile")) {
+            return;
+        }
+
+        for (int depth : {1, 8}) {
+            af::Cascade<float> cascade(48000.0, "Cascade");
+            for (int d = 0; d < depth; d++) {
+                cascade.add_filter(af::ChebyshevLowpass<float>(48000.0, "IIR LPF", 2, 3000.0 + 100.0 * d, 1.0));
+            }
+
+            std::vector<float> input = noise<float>(BLOCK);
+            std::vector<float> output(BLOCK);
+            auto run = [&](const std::string& suffix) {
+                auto t = suite.measure([&] {
+                    for (std::size_t i = 0; i < BLOCK; i++) {
+                        output[i] = cascade.filter(input[i]);
+                    }
+                }, BLOCK);
+                suite.add({"profile", "Cascade", "float", 2, depth, "sample" + suffix, BLOCK, "sample", t.first, t.second});
+
+                t = suite.measure([&] {
+                    cascade.filter_block(input.data(), output.data(), BLOCK);
+                }, BLOCK);
+                suite.add({"profile", "Cascade", "float", 2, depth, "block" + suffix, BLOCK, "sample", t.first, t.second});
+            };
+
+#ifdef AF_CASCADE_PROFILING
+            for (bool enable : {false, true}) {
+                cascade.set_profiling(enable);
+                run(enable ? "_profiled" : "_plain");
+            }
+#else
+            run("_default");
+#endif
+        }
+    }
+
+    /**
+     * @brief Per-channel filtering of interleaved float frames: deinterleave / filter / interleave copies,
+     * * filter_block_strided() in place, and frame by frame (sequential memory access, one filter() call per sample).
+     */
+    template <typename F>
+    void bench_strided_filter(Suite& suite, const std::string& name, const F& prototype, int order)
+    {
+        const std::size_t frames = 4096;
+        for (int channels : {2, 8}) {
+            std::vector<float> data = noise<float>(frames * channels);
+            std::vector<float> buffer(frames);
+            std::vector<F> filters(channels, prototype);
+            std::size_t samples = frames * channels;
+
+            auto t = suite.measure([&] {
+                for (int c = 0; c < channels; c++) {
+                    for (std::size_t i = 0; i < frames; i++) {
+                        buffer[i] = data[i * channels + c];
+                    }
+                    filters[c].filter_block(buffer.data(), buffer.data(), frames);
+                    for (std::size_t i = 0; i < frames; i++) {
+                        data[i * channels + c] = buffer[i];
+                    }
+                }
+            }, samples);
+            suite.add({"strided", name + " x" + std::to_string(channels), "float", order, 1, "copy", frames, "sample", t.first, t.second});
+
+            t = suite.measure([&] {
+                for (int c = 0; c < channels; c++) {
+                    filters[c].filter_block_strided(data.data() + c, channels, frames);
+                }
+            }, samples);
+            suite.add({"strided", name + " x" + std::to_string(channels), "float", order, 1, "strided", frames, "sample", t.first, t.second});
+
+            t = suite.measure([&] {
+                float* frame = data.data();
+                for (std::size_t i = 0; i < frames; i++, frame += channels) {
+                    for (int c = 0; c < channels; c++) {
+                        frame[c] = filters[c].filter(frame[c]);
+                    }
+                }
+            }, samples);
+            suite.add({"strided", name + " x" + std::to_string(channels), "float", order, 1, "frame_major", frames, "sample", t.first, t.second});
+        }
+    }
+
+    void bench_strided(Suite& suite)
+    {
+        if (!suite.enabled("strided")) {
+            return;
+        }
+
+        bench_strided_filter(suite, "ChebyshevLowpass", af::ChebyshevLowpass<float>(48000.0, "IIR LPF", 2, 3000.0, 1.0), 2);
+        bench_strided_filter(suite, "StateVariable", af::StateVariable<float>(48000.0, "SVF", af::SVF_Mode::Lowpass, 3000.0, 0.707), 2);
+        bench_strided_filter(suite, "FIR", af::FIR<float>(48000.0, "FIR", noise<float>(65, 7)), 64);
+    }
+
+    /**
+     * @brief Three passes (PCM to float, filter, float to PCM) against filter_block_pcm() with conversion fused into filtering.
+     */
+    void bench_pcm(Suite& suite)
+    {
+        if (!suite.enabled("pcm")) {
+            return;
+        }
+
+        const std::size_t block = 4096;
+        for (af::PCM_Format format : {af::PCM_Format::Int16, af::PCM_Format::Int24}) {
+            for (int channels : {1, 2}) {
+                std::vector<float> samples = noise<float>(block * channels);
+                std::vector<unsigned char> pcm(block * channels * af::pcm_sample_size(format));
+                std::vector<float> buffer(block);
+                af::pcm_encode(samples.data(), pcm.data(), format, 1, 0, samples.size());
+
+                std::vector<af::ChebyshevLowpass<float>> filters(channels, af::ChebyshevLowpass<float>(48000.0, "IIR LPF", 2, 3000.0, 1.0));
+                af::TPDF_Dither dither;
+                const std::size_t sample_size = af::pcm_sample_size(format);
+                std::string name = std::string(format == af::PCM_Format::Int16 ? "int16" : "int24") + " x" + std::to_string(channels);
+
+                auto t = suite.measure([&] {
+                    for (int c = 0; c < channels; c++) {
+                        af::pcm_decode(pcm.data(), format, channels, c, buffer.data(), block);
+                        filters[c].filter_block(buffer.data(), buffer.data(), block);
+                        af::pcm_encode(buffer.data(), pcm.data(), format, channels, c, block, &dither);
+                    }
+                }, block * channels);
+                suite.add({"pcm", name, "float", 2, 1, "three_pass", block, "sample", t.first, t.second});
+
+                t = suite.measure([&] {
+                    for (int c = 0; c < channels; c++) {
+                        filters[c].filter_block_pcm(pcm.data() + c * sample_size, pcm.data() + c * sample_size, block, format, channels, &dither);
+                    }
+                }, block * channels);
+                suite.add({"pcm", name, "float", 2, 1, "fused", block, "sample", t.first, t.second});
+            }
+        }
+    }
+
+    /**
+     * @brief Reproduces slowdown of decaying IIR feedback on subnormal floats and shows protections.
+     * * Filter gets one impulse and then only silence, so it's state decays into subnormal range.
+     */
+    void bench_denormals(Suite& suite)
+    {
+        if (!suite.enabled("denormal")) {
+            return;
+        }
+
+        std::vector<float> input = noise<float>(BLOCK);
+        std::vector<float> silence(BLOCK, 0.0f);
+        std::vector<float> out(BLOCK);
+
+        auto decayed = [&](bool flush) {
+            af::ChebyshevLowpass<float> filter(48000.0, "IIR LPF", 2, 1000.0, 1.0);
+            filter.set_flush_denormals(flush);
+            filter.filter(1.0f);
+            for (int i = 0; i < 4 * static_cast<int>(BLOCK); i++) {
+                filter.filter(0.0f);
+            }
+            return filter;
+        };
+        auto per_sample = [&](af::ChebyshevLowpass<float>& filter, const std::vector<float>& in) {
+            return [&] {
+                for (std::size_t i = 0; i < BLOCK; i++) {
+                    out[i] = filter.filter(in[i]);
+                }
+            };
+        };
+
+        af::ChebyshevLowpass<float> active(48000.0, "IIR LPF", 2, 1000.0, 1.0);
+        auto t = suite.measure(per_sample(active, input), BLOCK);
+        suite.add({"denormal", "ChebyshevLowpass", "float", 2, 1, "active_sample", BLOCK, "sample", t.first, t.second});
+
+        auto plain = decayed(false);
+        t = suite.measure(per_sample(plain, silence), BLOCK);
+        suite.add({"denormal", "ChebyshevLowpass", "float", 2, 1, "decayed_sample", BLOCK, "sample", t.first, t.second});
+
+        auto guarded = decayed(false);
+        t = suite.measure([&] {
+            guarded.filter_block(silence.data(), out.data(), BLOCK);
+        }, BLOCK);
+        suite.add({"denormal", "ChebyshevLowpass", "float", 2, 1, "decayed_ftz", BLOCK, "sample", t.first, t.second});
+
+        auto flushed = decayed(true);
+        t = suite.measure(per_sample(flushed, silence), BLOCK);
+        suite.add({"denormal", "ChebyshevLowpass", "float", 2, 1, "decayed_flush", BLOCK, "sample", t.first, t.second});
+    }
+
+    /**
+     * @brief Rectangular-window lowpass calculated with one std::sin call per tap (reference for design benchmark).
+     */
+    std::vector<double> lowpass_per_tap_sin(double fs, int order, double freq_cutoff)
+    {
+        std::vector<double> coeff(order + 1);
+        double omega = 2.0 * M_PI * (freq_cutoff / fs);
+        double M = order / 2.0;
+
+        for (int i = 0; i < order + 1; i++) {
+            double n = static_cast<double>(i) - M;
+            coeff[i] = (n == 0) ? omega / M_PI : std::sin(omega * n) / (M_PI * n);
+        }
+
+        return coeff;
+    }
+
+    /**
+     * @brief Measures design throughput of FIR lowpass sweeps (unit is one design, all designs are kept).
+     */
+    void bench_coeff_design(Suite& suite)
+    {
+        if (!suite.enabled("coeff")) {
+            return;
+        }
+
+        const double fs = 48000.0;
+        const std::size_t designs = 1000;
+        std::vector<double> cutoff(designs);
+        for (std::size_t d = 0; d < designs; d++) {
+            cutoff[d] = 20.0 + 20000.0 * static_cast<double>(d) / designs;
+        }
+
+        af::Design_Cache<double>::instance().set_capacity(0);
+
+        for (int order : {32, 256, 2048}) {
+            auto t = suite.measure([&] {
+                std::vector<std::vector<double>> coeffs;
+                coeffs.reserve(designs);
+                for (double fc : cutoff) {
+                    coeffs.push_back(lowpass_per_tap_sin(fs, order, fc));
+                }
+                suite.sink(coeffs.back()[order / 2]);
+            }, designs);
+            suite.add({"coeff", "per_tap_sin", "double", order, 1, "reference", designs, "design", t.first, t.second});
+
+            t = suite.measure([&] {
+                std::vector<af::Lowpass<double>> filters;
+                filters.reserve(designs);
+                for (double fc : cutoff) {
+                    filters.emplace_back(fs, "LPF", order, fc);
+                }
+                suite.sink(filters.back().get_coeff()[order / 2]);
+            }, designs);
+            suite.add({"coeff", "Lowpass", "double", order, 1, "constructor", designs, "design", t.first, t.second});
+
+            t = suite.measure([&] {
+                auto filters = af::lowpass_batch<double>(fs, "LPF", order, cutoff);
+                suite.sink(filters.back().get_coeff()[order / 2]);
+            }, designs);
+            suite.add({"coeff", "Lowpass", "double", order, 1, "lowpass_batch", designs, "design", t.first, t.second});
+
+            t = suite.measure([&] {
+                auto coeffs = af::lowpass_coeff_batch<double>(fs, order, cutoff);
+                suite.sink(coeffs.back()[order / 2]);
+            }, designs);
+            suite.add({"coeff", "Lowpass", "double", order, 1, "coeff_batch", designs, "design", t.first, t.second});
+        }
+
+        af::Design_Cache<double>::instance().set_capacity(1024);
+    }
+
+    /**
+     * @brief Measures cost of saving and restoring state of cascade every block (checkpointing), unit is one block.
+     */
+    void bench_state(Suite& suite)
+    {
+        if (!suite.enabled("state")) {
+            return;
+        }
+
+        af::Lowpass<float> LP_filter(48000.0, "FIR LPF", 256, 3000.0);
+        af::ChebyshevHighpass<float> HP_filter(48000.0, "IIR HPF", 2, 100.0, 1.0);
+        auto cascade = LP_filter + HP_filter;
+        std::vector<unsigned char> state(cascade->state_size());
+
+        auto t = suite.measure([&] {
+            cascade->save_state(state.data(), state.size());
+        }, 1);
+        suite.add({"state", "Cascade", "float", 256, 2, "save_state", state.size(), "block", t.first, t.second});
+
+        t = suite.measure([&] {
+            cascade->load_state(state.data(), state.size());
+        }, 1);
+        suite.add({"state", "Cascade", "float", 256, 2, "load_state", state.size(), "block", t.first, t.second});
+    }
+
+
+    /**
+     * @brief Measures frequency response of cascade (1024 points) from coeffitients against measuring impulse response, unit is one call.
+     */
+    void bench_response(Suite& suite)
+    {
+        if (!suite.enabled("response")) {
+            return;
+        }
+
+        const std::size_t POINTS = 1024;
+        af::Lowpass<float> LP_filter(48000.0, "FIR LPF", 256, 3000.0);
+        af::ChebyshevHighpass<float> HP_filter(48000.0, "IIR HPF", 2, 100.0, 1.0);
+        auto cascade = LP_filter + HP_filter;
+
+        auto t = suite.measure([&] {
+            std::vector<std::complex<double>> response = cascade->frequency_response(POINTS);
+            suite.sink(response[1].real());
+        }, 1);
+        suite.add({"response", "Cascade", "float", 256, 2, "fft_grid", POINTS, "call", t.first, t.second});
+
+        std::vector<double> freq(POINTS);
+        for (std::size_t k = 0; k < POINTS; k++) {
+            freq[k] = 24000.0 * static_cast<double>(k) / static_cast<double>(POINTS);
+        }
+        std::vector<std::complex<double>> response(POINTS);
+        t = suite.measure([&] {
+            cascade->frequency_response(freq.data(), response.data(), POINTS);
+            suite.sink(response[1].real());
+        }, 1);
+        suite.add({"response", "Cascade", "float", 256, 2, "arbitrary", POINTS, "call", t.first, t.second});
+
+        t = suite.measure([&] {
+            cascade->af::Base_Filter<float>::frequency_response(freq.data(), response.data(), POINTS);
+            suite.sink(response[1].real());
+        }, 1);
+        suite.add({"response", "Cascade", "float", 256, 2, "impulse", POINTS, "call", t.first, t.second});
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv);
+    std::cout << "dsp_bench, cycle counter ticks per ns: " << af::cycles_per_ns() << std::endl;
+    suite.print_header();
+
+#ifdef AF_CASCADE_PROFILING
+    // instrumented Cascade would skew every other group, they run in dsp_bench
+    bench_profiling(suite);
+#else
+    bench_fir<float>(suite);
+    bench_fir<double>(suite);
+    bench_iir<float>(suite);
+    bench_iir<double>(suite);
+    bench_designs<float>(suite);
+    bench_designs<double>(suite);
+    bench_cascade<float>(suite);
+    bench_cascade<double>(suite);
+    bench_sos<float>(suite);
+    bench_sos<double>(suite);
+    bench_average<float>(suite);
+    bench_average<double>(suite);
+    bench_sparse<float>(suite);
+    bench_sparse<double>(suite);
+    bench_multirate<float>(suite);
+    bench_multirate<double>(suite);
+    bench_tiled(suite);
+    bench_profiling(suite);
+    bench_pcm(suite);
+    bench_strided(suite);
+    bench_denormals(suite);
+    bench_coeff_design(suite);
+    bench_state(suite);
+    bench_response(suite);
+#endif
+
+    if (!suite.write_json()) {
+        std::cout << "Could not write JSON report" << std::endl;
+        return 1;
+    }
+
+    return suite.get_sink() == 12345.0 ? 2 : 0;
+}
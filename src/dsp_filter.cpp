@@ -0,0 +1,606 @@
+#include "headers/base_filter.hpp"
+#include "headers/FIRs.hpp"
+#include "headers/IIRs.hpp"
+#include "headers/SVFs.hpp"
+#include "headers/filter_cascade.hpp"
+#include "headers/filter_bank.hpp"
+#include "headers/mapped_file.hpp"
+#include "headers/pcm_io.hpp"
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <algorithm>
+
+// Filters WAV or raw PCM files (int16, int24, float32, any number of channels) with cascade given by spec.
+// Input is memory mapped, output file is mapped writable - samples are converted straight from input mapping
+// to one block buffer per channel, filtered in place and converted straight into output mapping.
+// With INPUT and OUTPUT "-" it streams stdin to stdout: reading, filtering and writing run on separate threads
+// and pass pre-allocated blocks through queues, so reading next block, filtering current one and writing previous one overlap.
+
+namespace {
+
+    struct Options {
+        std::string spec;
+        std::string input;
+        std::string output;
+        bool raw = false;
+        af::PCM_Format format = af::PCM_Format::Int16;
+        int channels = 1;
+        double sampling_freq = 0.0;
+        std::size_t block = 0;
+        std::size_t blocks = 4;
+        bool use_double = false;
+        bool dither = false;
+    };
+
+    void print_usage()
+    {
+        std::cerr << "Usage: dsp_filter [options] SPEC INPUT OUTPUT\n"
+                  << "       dsp_filter [options] SPEC - -   (stream stdin to stdout, WAV header is passed through)\n"
+                  << "  SPEC is list of stages joined with '+', for example lowpass:128:3000+cheb_highpass:100:1\n"
+                  << "    lowpass:ORDER:FC  highpass:ORDER:FC  bandpass:ORDER:F1:F2  bandstop:ORDER:F1:F2\n"
+                  << "    cheb_lowpass:FC:RIPPLE[:ORDER]  cheb_highpass:FC:RIPPLE[:ORDER]  (ORDER default 2)\n"
+                  << "    cheb2_lowpass:FC:ATTEN:ORDER  cheb2_highpass:FC:ATTEN:ORDER  butter_lowpass:FC:ORDER  butter_highpass:FC:ORDER\n"
+                  << "    ellip_lowpass|ellip_highpass:FPASS:FSTOP:RIPPLE:ATTEN  (minimal order elliptic)\n"
+                  << "    ellip_bandpass|ellip_bandstop:FPASS1:FPASS2:FSTOP1:FSTOP2:RIPPLE:ATTEN\n"
+                  << "    svf:lowpass|highpass|bandpass|notch:FC:Q  moving_average:LENGTH\n"
+                  << "    halfband:TRANSITION:ATTEN  hilbert:TRANSITION:ATTEN  (minimal order, zero taps are skipped)\n"
+                  << "    bank:PATH (all filters of filter bank file, stored in double needs --double)\n"
+                  << "Options:\n"
+                  << "  --raw s16|s24|f32  input is raw interleaved PCM (little endian), needs --rate\n"
+                  << "  --channels N       number of channels of raw input (default 1)\n"
+                  << "  --rate HZ          sampling frequency of raw input\n"
+                  << "  --block N          frames per block (default 4096, 256 when streaming)\n"
+                  << "  --blocks N         number of blocks in flight when streaming (default 4, at least 3)\n"
+                  << "  --double           process in double precision\n"
+                  << "  --dither           add TPDF dither when writing int16/int24\n";
+    }
+
+    bool parse_options(int argc, char** argv, Options& options)
+    {
+        std::vector<std::string> positional;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+
+            if (arg == "--raw" && has_value) {
+                options.raw = true;
+                if (!af::parse_pcm_format(argv[++i], options.format)) {
+                    return false;
+                }
+            }
+            else if (arg == "--channels" && has_value) {
+                options.channels = std::atoi(argv[++i]);
+            }
+            else if (arg == "--rate" && has_value) {
+                options.sampling_freq = std::atof(argv[++i]);
+            }
+            else if (arg == "--block" && has_value) {
+                options.block = static_cast<std::size_t>(std::atol(argv[++i]));
+            }
+            else if (arg == "--blocks" && has_value) {
+                options.blocks = static_cast<std::size_t>(std::atol(argv[++i]));
+            }
+            else if (arg == "--double") {
+                options.use_double = true;
+            }
+            else if (arg == "--dither") {
+                options.dither = true;
+            }
+            else if (arg.size() > 1 && arg[0] == '-') {
+                return false;
+            }
+            else {
+                positional.push_back(arg);
+            }
+        }
+
+        if (positional.size() != 3 || options.channels <= 0 || options.blocks < 3) {
+            return false;
+        }
+
+        options.spec = positional[0];
+        options.input = positional[1];
+        options.output = positional[2];
+        if (options.block == 0) {
+            options.block = options.input == "-" ? 256 : 4096;
+        }
+        return (options.input == "-") == (options.output == "-");
+    }
+
+    std::vector<std::string> split(const std::string& text, char separator)
+    {
+        std::vector<std::string> parts;
+        std::stringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, separator)) {
+            parts.push_back(part);
+        }
+        return parts;
+    }
+
+    /**
+     * @brief Builds one stage (or stages of filter bank) from spec and adds it to cascade.
+     * @return Returns false if spec is not valid.
+     */
+    template <typename T>
+    bool add_stage(af::Cascade<T>& cascade, const std::string& spec)
+    {
+        std::vector<std::string> part = split(spec, ':');
+        const double fs = cascade.get_sampling_freq();
+        auto number = [&](std::size_t i) { return std::atof(part[i].c_str()); };
+
+        if (part.empty()) {
+            return false;
+        }
+
+        const std::string& kind = part[0];
+        if (kind == "lowpass" && part.size() == 3) {
+            return cascade.add_filter(af::Lowpass<T>(fs, spec, static_cast<int>(number(1)), number(2)));
+        }
+        if (kind == "highpass" && part.size() == 3) {
+            return cascade.add_filter(af::Highpass<T>(fs, spec, static_cast<int>(number(1)), number(2)));
+        }
+        if (kind == "bandpass" && part.size() == 4) {
+            return cascade.add_filter(af::Bandpass<T>(fs, spec, static_cast<int>(number(1)), number(2), number(3)));
+        }
+        if (kind == "bandstop" && part.size() == 4) {
+            return cascade.add_filter(af::Bandstop<T>(fs, spec, static_cast<int>(number(1)), number(2), number(3)));
+        }
+        if (kind == "cheb_lowpass" && (part.size() == 3 || part.size() == 4)) {
+            int order = part.size() == 4 ? static_cast<int>(number(3)) : 2;
+            af::ChebyshevLowpass<T> filter(fs, spec, order, number(1), number(2));
+            return filter.get_section_count() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "cheb_highpass" && (part.size() == 3 || part.size() == 4)) {
+            int order = part.size() == 4 ? static_cast<int>(number(3)) : 2;
+            af::ChebyshevHighpass<T> filter(fs, spec, order, number(1), number(2));
+            return filter.get_section_count() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "cheb2_lowpass" && part.size() == 4) {
+            af::Chebyshev2Lowpass<T> filter(fs, spec, static_cast<int>(number(3)), number(1), number(2));
+            return filter.get_section_count() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "cheb2_highpass" && part.size() == 4) {
+            af::Chebyshev2Highpass<T> filter(fs, spec, static_cast<int>(number(3)), number(1), number(2));
+            return filter.get_section_count() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "butter_lowpass" && part.size() == 3) {
+            af::ButterworthLowpass<T> filter(fs, spec, static_cast<int>(number(2)), number(1));
+            return filter.get_section_count() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "butter_highpass" && part.size() == 3) {
+            af::ButterworthHighpass<T> filter(fs, spec, static_cast<int>(number(2)), number(1));
+            return filter.get_section_count() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "ellip_lowpass" && part.size() == 5) {
+            af::EllipticLowpass<T> filter(fs, spec, af::IIR_Spec{number(1), number(2), number(3), number(4)});
+            return filter.get_order() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "ellip_highpass" && part.size() == 5) {
+            af::EllipticHighpass<T> filter(fs, spec, af::IIR_Spec{number(1), number(2), number(3), number(4)});
+            return filter.get_order() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "ellip_bandpass" && part.size() == 7) {
+            af::EllipticBandpass<T> filter(fs, spec, af::IIR_Band_Spec{number(1), number(2), number(3), number(4), number(5), number(6)});
+            return filter.get_order() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "ellip_bandstop" && part.size() == 7) {
+            af::EllipticBandstop<T> filter(fs, spec, af::IIR_Band_Spec{number(1), number(2), number(3), number(4), number(5), number(6)});
+            return filter.get_order() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "svf" && part.size() == 4) {
+            af::SVF_Mode mode;
+            if (part[1] == "lowpass") {
+                mode = af::SVF_Mode::Lowpass;
+            }
+            else if (part[1] == "highpass") {
+                mode = af::SVF_Mode::Highpass;
+            }
+            else if (part[1] == "bandpass") {
+                mode = af::SVF_Mode::Bandpass;
+            }
+            else if (part[1] == "notch") {
+                mode = af::SVF_Mode::Notch;
+            }
+            else {
+                return false;
+            }
+            return cascade.add_filter(af::StateVariable<T>(fs, spec, mode, number(2), number(3)));
+        }
+        if (kind == "moving_average" && part.size() == 2) {
+            int length = static_cast<int>(number(1));
+            return length > 0 && cascade.add_filter(af::MovingAverage<T>(fs, spec, static_cast<std::size_t>(length)));
+        }
+        if (kind == "halfband" && part.size() == 3) {
+            af::Lowpass<T> filter = af::halfband_lowpass<T>(fs, spec, number(1), number(2));
+            return filter.get_order() > 0 && cascade.add_filter(filter);
+        }
+        if (kind == "hilbert" && part.size() == 3) {
+            af::FIR<T> filter = af::hilbert<T>(fs, spec, number(1), number(2));
+            return !filter.get_coeff().empty() && cascade.add_filter(filter);
+        }
+        if (kind == "bank" && part.size() == 2) {
+            auto filters = af::load_filter_bank<T>(part[1]);
+            for (auto& filter : filters) {
+                // boxcar FIRs run as recursive moving average, O(1) per sample
+                auto fir = dynamic_cast<af::FIR<T>*>(filter.get());
+                if (fir && fir->is_moving_average()) {
+                    filter = fir->fast_form();
+                }
+                if (!cascade.add_filter(std::move(filter))) {
+                    return false;
+                }
+            }
+            return !filters.empty();
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    std::unique_ptr<af::Cascade<T>> build_cascade(const std::string& spec, double sampling_freq)
+    {
+        auto cascade = std::make_unique<af::Cascade<T>>(sampling_freq, spec);
+        for (const std::string& stage : split(spec, '+')) {
+            if (!add_stage(*cascade, stage)) {
+                std::cerr << "Invalid filter stage: " << stage << std::endl;
+                return nullptr;
+            }
+        }
+
+        double latency = cascade->get_latency();
+        std::cerr << "Filter latency: " << latency << " samples (" << latency / sampling_freq * 1e3 << " ms)" << std::endl;
+        return cascade;
+    }
+
+    /**
+     * @brief Channel_Processor filters interleaved PCM blocks, every channel has own clone of cascade (and dither generator).
+     */
+    template <typename T>
+    class Channel_Processor {
+        private:
+            af::PCM_Info m_info;
+            std::vector<std::unique_ptr<af::Base_Filter<T>>> m_filters;
+            std::vector<af::TPDF_Dither> m_dither;
+
+        public:
+            Channel_Processor(const af::Base_Filter<T>& cascade, const af::PCM_Info& info, bool dither) : m_info(info) {
+                for (int c = 0; c < info.channels; c++) {
+                    m_filters.push_back(cascade.clone());
+                    if (dither) {
+                        m_dither.emplace_back(0x9E3779B9u * static_cast<std::uint32_t>(c + 1));
+                    }
+                }
+            }
+
+            /**
+             * @brief Filters block of interleaved frames. Input and output may be the same memory.
+             * @param frames Number of frames.
+             */
+            void process(const unsigned char* input, unsigned char* output, std::size_t frames) {
+                const std::size_t sample_size = af::pcm_sample_size(m_info.format);
+                for (int c = 0; c < m_info.channels; c++) {
+                    m_filters[c]->filter_block_pcm(input + c * sample_size, output + c * sample_size, frames, m_info.format, m_info.channels,
+                                                   m_dither.empty() ? nullptr : &m_dither[c]);
+                }
+            }
+    };
+
+    /**
+     * @brief Filters all frames of mapped file block by block.
+     * @return Returns false if spec is not valid.
+     */
+    template <typename T>
+    bool process_file(const Options& options, const af::PCM_Info& info, const unsigned char* input, unsigned char* output)
+    {
+        auto cascade = build_cascade<T>(options.spec, info.sampling_freq);
+        if (!cascade) {
+            return false;
+        }
+
+        Channel_Processor<T> processor(*cascade, info, options.dither);
+        const std::size_t frame_size = af::pcm_sample_size(info.format) * static_cast<std::size_t>(info.channels);
+
+        for (std::size_t frame = 0; frame < info.frames; frame += options.block) {
+            std::size_t frames = std::min(options.block, info.frames - frame);
+            processor.process(input + frame * frame_size, output + frame * frame_size, frames);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Blocking queue of block indices with fixed capacity (no allocation after construction).
+     * * Counts how many times pop() had to wait for data.
+     */
+    class Index_Queue {
+        private:
+            std::vector<std::size_t> m_items;
+            std::size_t m_head = 0;
+            std::size_t m_count = 0;
+            std::size_t m_waits = 0;
+            std::mutex m_mutex;
+            std::condition_variable m_ready;
+
+        public:
+            explicit Index_Queue(std::size_t capacity) : m_items(capacity) {}
+
+            void push(std::size_t index) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_items[(m_head + m_count) % m_items.size()] = index;
+                    m_count++;
+                }
+                m_ready.notify_one();
+            }
+
+            std::size_t pop() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if (m_count == 0) {
+                    m_waits++;
+                    m_ready.wait(lock, [this] { return m_count > 0; });
+                }
+                std::size_t index = m_items[m_head];
+                m_head = (m_head + 1) % m_items.size();
+                m_count--;
+                return index;
+            }
+
+            /**
+             * @brief Takes index without waiting.
+             * @return Returns false if queue is empty.
+             */
+            bool try_pop(std::size_t& index) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_count == 0) {
+                    return false;
+                }
+                index = m_items[m_head];
+                m_head = (m_head + 1) % m_items.size();
+                m_count--;
+                return true;
+            }
+
+            std::size_t get_waits() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_waits;
+            }
+    };
+
+    /**
+     * @brief Block of stream: PCM bytes, number of frames (0 marks end of stream) and time when it was read.
+     */
+    struct Stream_Block {
+        std::vector<unsigned char> data;
+        std::size_t frames = 0;
+        std::chrono::steady_clock::time_point read_time;
+    };
+
+    /**
+     * @brief Reads WAV header from stream and writes it unchanged to output.
+     * @return Returns false if stream does not start with supported WAV header.
+     */
+    bool pass_wav_header(std::FILE* input, std::FILE* output, af::PCM_Info& info)
+    {
+        std::vector<unsigned char> header(12);
+        if (std::fread(header.data(), 1, 12, input) != 12) {
+            return false;
+        }
+
+        while (header.size() < (1u << 20)) {
+            std::size_t position = header.size();
+            header.resize(position + 8);
+            if (std::fread(header.data() + position, 1, 8, input) != 8) {
+                return false;
+            }
+
+            if (std::memcmp(header.data() + position, "data", 4) == 0) {
+                if (!af::parse_wav_header(header.data(), header.size(), info)) {
+                    return false;
+                }
+                return std::fwrite(header.data(), 1, header.size(), output) == header.size();
+            }
+
+            std::size_t chunk_size = af::pcm_read_le(header.data() + position + 4, 4);
+            chunk_size += chunk_size & 1;
+            if (chunk_size > (1u << 20)) {
+                return false;
+            }
+            header.resize(position + 8 + chunk_size);
+            if (std::fread(header.data() + position + 8, 1, chunk_size, input) != chunk_size) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Streams PCM from stdin to stdout on three threads (reader, filter, writer).
+     * * Latency of block is time from the end of it's reading to the end of it's writing.
+     * * Underrun is writer waiting for block which was already read (filtering did not keep up),
+     * * overrun is reader waiting for free block (writing did not keep up).
+     * @return Returns false if spec is not valid or output failed.
+     */
+    template <typename T>
+    bool process_stream(const Options& options, const af::PCM_Info& info)
+    {
+        auto cascade = build_cascade<T>(options.spec, info.sampling_freq);
+        if (!cascade) {
+            return false;
+        }
+
+        Channel_Processor<T> processor(*cascade, info, options.dither);
+        const std::size_t frame_size = af::pcm_sample_size(info.format) * static_cast<std::size_t>(info.channels);
+
+        std::vector<Stream_Block> blocks(options.blocks);
+        Index_Queue free_blocks(options.blocks);
+        Index_Queue read_blocks(options.blocks);
+        Index_Queue filtered_blocks(options.blocks);
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            blocks[i].data.resize(options.block * frame_size);
+            free_blocks.push(i);
+        }
+
+        std::vector<double> latency;
+        latency.reserve(1 << 16);
+        std::size_t total_frames = 0;
+        std::size_t underruns = 0;
+        bool write_ok = true;
+
+        std::thread reader([&] {
+            for (;;) {
+                std::size_t index = free_blocks.pop();
+                Stream_Block& block = blocks[index];
+                std::size_t bytes = std::fread(block.data.data(), 1, block.data.size(), stdin);
+                block.frames = bytes / frame_size;
+                block.read_time = std::chrono::steady_clock::now();
+                bool end = block.frames == 0;
+                read_blocks.push(index);
+                if (end) {
+                    return;
+                }
+            }
+        });
+
+        std::thread filterer([&] {
+            for (;;) {
+                std::size_t index = read_blocks.pop();
+                Stream_Block& block = blocks[index];
+                bool end = block.frames == 0;
+                processor.process(block.data.data(), block.data.data(), block.frames);
+                filtered_blocks.push(index);
+                if (end) {
+                    return;
+                }
+            }
+        });
+
+        for (;;) {
+            std::size_t index;
+            if (!filtered_blocks.try_pop(index)) {
+                auto wait_start = std::chrono::steady_clock::now();
+                index = filtered_blocks.pop();
+                if (blocks[index].frames > 0 && blocks[index].read_time < wait_start) {
+                    underruns++;
+                }
+            }
+
+            Stream_Block& block = blocks[index];
+            if (block.frames == 0) {
+                break;
+            }
+
+            std::size_t bytes = block.frames * frame_size;
+            write_ok = write_ok && std::fwrite(block.data.data(), 1, bytes, stdout) == bytes && std::fflush(stdout) == 0;
+            latency.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - block.read_time).count());
+            total_frames += block.frames;
+            free_blocks.push(index);
+        }
+
+        reader.join();
+        filterer.join();
+
+        std::sort(latency.begin(), latency.end());
+        auto percentile = [&](double p) {
+            return latency.empty() ? 0.0 : latency[static_cast<std::size_t>(p * static_cast<double>(latency.size() - 1))];
+        };
+
+        std::cerr << "Streamed " << total_frames << " frames x " << info.channels << " channels in " << latency.size() << " blocks of " << options.block << " frames\n"
+                  << "Latency (read to written) us: p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 " << percentile(0.99)
+                  << ", max " << percentile(1.0) << "\n"
+                  << "Underruns (writer waited for filter): " << underruns
+                  << ", overruns (reader waited for free block): " << free_blocks.get_waits() << std::endl;
+
+        return write_ok;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return 1;
+    }
+
+    if (options.input == "-") {
+        af::PCM_Info info;
+        if (options.raw) {
+            if (options.sampling_freq <= 0) {
+                std::cerr << "Raw input needs --rate" << std::endl;
+                return 1;
+            }
+            info.format = options.format;
+            info.channels = options.channels;
+            info.sampling_freq = options.sampling_freq;
+        }
+        else if (!pass_wav_header(stdin, stdout, info)) {
+            std::cerr << "Unsupported WAV stream (use --raw for raw PCM)" << std::endl;
+            return 1;
+        }
+
+        bool ok = options.use_double ? process_stream<double>(options, info) : process_stream<float>(options, info);
+        return ok ? 0 : 1;
+    }
+
+    af::Mapped_File input(options.input);
+    if (!input.is_open()) {
+        std::cerr << "Cannot open input file " << options.input << std::endl;
+        return 1;
+    }
+    input.advise_sequential();
+
+    af::PCM_Info info;
+    if (options.raw) {
+        if (options.sampling_freq <= 0) {
+            std::cerr << "Raw input needs --rate" << std::endl;
+            return 1;
+        }
+        info.format = options.format;
+        info.channels = options.channels;
+        info.sampling_freq = options.sampling_freq;
+        info.data_offset = 0;
+        info.frames = input.size() / (af::pcm_sample_size(info.format) * info.channels);
+    }
+    else if (!af::parse_wav_header(input.data(), input.size(), info)) {
+        std::cerr << "Unsupported WAV file (use --raw for raw PCM)" << std::endl;
+        return 1;
+    }
+
+    // Output keeps everything outside of sample data (header, other chunks) unchanged.
+    af::Mapped_Output_File output(options.output, input.size());
+    if (!output.is_open()) {
+        std::cerr << "Cannot create output file " << options.output << std::endl;
+        return 1;
+    }
+
+    const std::size_t data_size = info.frames * af::pcm_sample_size(info.format) * static_cast<std::size_t>(info.channels);
+    std::copy(input.data(), input.data() + info.data_offset, output.data());
+    std::copy(input.data() + info.data_offset + data_size, input.data() + input.size(), output.data() + info.data_offset + data_size);
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = options.use_double
+        ? process_file<double>(options, info, input.data() + info.data_offset, output.data() + info.data_offset)
+        : process_file<float>(options, info, input.data() + info.data_offset, output.data() + info.data_offset);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!ok || !output.close()) {
+        return 1;
+    }
+
+    double audio_seconds = static_cast<double>(info.frames) / info.sampling_freq;
+    std::cerr << "Processed " << info.frames << " frames x " << info.channels << " channels (" << audio_seconds << " s of audio) in "
+              << seconds << " s: " << audio_seconds / seconds << "x real time, "
+              << static_cast<double>(info.frames * info.channels) / seconds * 1e-6 << " Msamples/s, "
+              << static_cast<double>(data_size) / seconds * 1e-6 << " MB/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "headers/base_filter.hpp"
+#include "headers/FIRs.hpp"
+#include "headers/IIRs.hpp"
+#include "headers/filter_cascade.hpp"
+#include "headers/filter_bank.hpp"
+#include <iostream>
+
+int main()
+{
+    af::Lowpass<double> LP_filter(44100.0, "FIR LPF", 60, 3000.0);
+    af::ChebyshevHighpass<double> HP_filter(44100.0, "IIR HPF", 2, 300.0, 1.0);
+    auto Cascade_bandpass = LP_filter + HP_filter;
+
+    std::cout << "Writing filter bank with FIR, IIR and their cascade to filter_bank.bin" << std::endl;
+    if (!af::write_filter_bank<double>("filter_bank.bin", {&LP_filter, &HP_filter, Cascade_bandpass.get()})) {
+        std::cout << "Writing failed" << std::endl;
+        return 1;
+    }
+
+    auto bank = af::load_filter_bank<double>("filter_bank.bin");
+    std::cout << "Loaded " << bank.size() << " filters (coeffitients are read from mapped file):" << std::endl;
+    for (auto& f : bank) {
+        std::cout << "- " << f->get_filter_name() << ", sampling frequency " << f->get_sampling_freq() << std::endl;
+    }
+    std::cout << std::endl;
+
+    double sample[] = {1, -1, 1, 0, 1, -1, 1, 0, 1, -1, 0, 1};
+    std::cout << "Original cascade output: [ ";
+    for (double s : sample) {
+        std::cout << Cascade_bandpass->filter(s) << " ";
+    }
+    std::cout << "]" << std::endl;
+
+    std::cout << "Loaded cascade output:   [ ";
+    for (double s : sample) {
+        std::cout << bank[2]->filter(s) << " ";
+    }
+    std::cout << "]" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,351 @@
+#define AF_RT_CHECK_HOOKS
+#include "headers/rt_check.hpp"
+#include "headers/base_filter.hpp"
+#include "headers/filter_type.hpp"
+#include "headers/FIRs.hpp"
+#include "headers/IIRs.hpp"
+#include "headers/SVFs.hpp"
+#include "headers/filter_cascade.hpp"
+#include "headers/multirate.hpp"
+#include <cmath>
+#include <iostream>
+#include <functional>
+#include <mutex>
+
+// Certifies filter classes as allocation and lock free in steady state (built with AF_RT_CHECK, see rt_check.hpp)
+// and checks that filters designed from specification meet it.
+// Returns non-zero exit code if any class or design fails or if the checker misses deliberate violations.
+
+namespace {
+
+    const std::size_t BLOCK = 256;
+
+    /**
+     * @brief Filter breaking real-time rules on purpose, used to check that checker works.
+     */
+    class Allocating_Filter : public af::Base_Filter<float> {
+        private:
+            std::mutex m_mutex;
+            bool m_lock;
+
+        public:
+            Allocating_Filter(bool lock) : af::Base_Filter<float>(48000.0, lock ? "Locking filter" : "Allocating filter"), m_lock(lock) {}
+
+            float filter(float input) override {
+                AF_RT_SCOPE();
+                if (m_lock) {
+                    std::lock_guard<std::mutex> guard(m_mutex);
+                    return input;
+                }
+                std::vector<float> scratch(16, input);
+                return scratch[15];
+            }
+
+            std::unique_ptr<af::Base_Filter<float>> clone() const override {
+                return std::make_unique<Allocating_Filter>(m_lock);
+            }
+
+            void reset() override {}
+    };
+
+    /**
+     * @brief Runs filter in steady state with checker in report mode.
+     * * First block is warm-up, then blocks and single samples are filtered, filter is reset and update (if given) is applied at block boundary.
+     * @param update Function requesting coeffitient update (called outside of filter, may allocate).
+     * @return Returns number of violations.
+     */
+    template <typename T>
+    std::size_t run_checked(af::Base_Filter<T>& filter, const std::function<void()>& update)
+    {
+        std::vector<T> input(BLOCK);
+        std::vector<T> output(std::max(BLOCK, filter.max_output(BLOCK)));
+        std::vector<unsigned char> state(filter.state_size());
+        for (std::size_t i = 0; i < BLOCK; i++) {
+            input[i] = static_cast<T>(std::sin(0.05 * static_cast<double>(i)));
+        }
+
+        filter.filter_block(input.data(), output.data(), BLOCK);
+        filter.save_state(state.data(), state.size());
+
+        af::RT_Check::clear();
+        af::RT_Check::set_mode(af::RT_Check_Mode::Report);
+
+        for (int block = 0; block < 16; block++) {
+            filter.filter_block(input.data(), output.data(), BLOCK);
+            filter.filter_block(output.data(), output.data(), BLOCK);
+            filter.filter_block_strided(output.data() + 1, 2, BLOCK / 2);
+            filter.process(input.data(), BLOCK, output.data());
+            for (std::size_t i = 0; i < BLOCK; i++) {
+                output[i] = filter.filter(input[i]);
+            }
+
+            {
+                af::RT_Scope scope("reset");
+                filter.reset();
+            }
+
+            if (update && block % 4 == 0) {
+                af::RT_Check::set_mode(af::RT_Check_Mode::Off);
+                update();
+                af::RT_Check::set_mode(af::RT_Check_Mode::Report);
+            }
+
+            af::RT_Scope scope("load_state");
+            filter.load_state(state.data(), state.size());
+        }
+
+        af::RT_Check::set_mode(af::RT_Check_Mode::Off);
+        return af::RT_Check::violation_count();
+    }
+
+    /**
+     * @brief Prints result of one certified class.
+     * @return Returns true if class has no violations.
+     */
+    bool report(const std::string& name, std::size_t violations)
+    {
+        std::cout << (violations == 0 ? "PASS  " : "FAIL  ") << name;
+        if (violations > 0) {
+            const af::RT_Violation_Record& first = af::RT_Check::get_violation(0);
+            std::cout << "  (" << violations << " violations, first: " << af::RT_Check::kind_name(first.kind)
+                      << " inside '" << first.filter_name << "')";
+        }
+        std::cout << std::endl;
+        return violations == 0;
+    }
+
+    /**
+     * @brief Checks that clone made in the middle of crossfade continues exactly like the original filter.
+     * @param update Function requesting coeffitient update with crossfade longer than 64 samples.
+     * @return Returns true if outputs of original and clone match.
+     */
+    template <typename T>
+    bool clone_during_fade(af::Base_Filter<T>& filter, const std::function<void()>& update)
+    {
+        std::vector<T> input(BLOCK);
+        for (std::size_t i = 0; i < BLOCK; i++) {
+            input[i] = static_cast<T>(std::sin(0.05 * static_cast<double>(i)));
+        }
+
+        update();
+        std::vector<T> output(BLOCK);
+        filter.filter_block(input.data(), output.data(), 32);
+        std::unique_ptr<af::Base_Filter<T>> clone = filter.clone();
+
+        for (std::size_t i = 0; i < BLOCK; i++) {
+            if (filter.filter(input[i]) != clone->filter(input[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Prints result of clone check (see clone_during_fade()).
+     * @return Returns given result.
+     */
+    bool report_clone(const std::string& name, bool ok)
+    {
+        std::cout << (ok ? "PASS  " : "FAIL  ") << name << " cloned during crossfade" << std::endl;
+        return ok;
+    }
+
+    /**
+     * @brief Prints result of check of designed response (see fir_spec_met() and iir_spec_met()).
+     * @return Returns given result.
+     */
+    bool report_spec(const std::string& name, bool ok)
+    {
+        std::cout << (ok ? "PASS  " : "FAIL  ") << name << " meets specification" << std::endl;
+        return ok;
+    }
+
+    /**
+     * @brief Checks coeffitients of designed FIR against ripple and attenuation of specification (see af::fir_meets_spec()).
+     * @return Returns true if filter has coeffitients and response is within tolerance in every band.
+     */
+    template <typename T>
+    bool fir_spec_met(const af::FIR<T>& filter, const std::vector<af::FIR_Spec_Band>& bands, double pass_ripple, double stop_atten)
+    {
+        const double gain = std::pow(10.0, pass_ripple / 20.0);
+        const std::vector<T> coeff = filter.get_coeff();
+        return !coeff.empty() && af::fir_meets_spec(coeff, filter.get_sampling_freq(), bands, (gain - 1.0) / (gain + 1.0), std::pow(10.0, -stop_atten / 20.0));
+    }
+
+    /**
+     * @brief Checks response of designed IIR against ripple and attenuation of specification (see af::Base_Filter::frequency_response()).
+     * * Passband magnitude has to stay between -pass_ripple and 0 dB, stopband magnitude below -stop_atten dB,
+     * * checked at 256 evenly spaced frequencies of every band including it's edges.
+     * @return Returns true if response is within tolerance in every band.
+     */
+    template <typename T>
+    bool iir_spec_met(const af::Base_Filter<T>& filter, const std::vector<af::FIR_Spec_Band>& bands, double pass_ripple, double stop_atten)
+    {
+        const std::size_t points = 256;
+        const double tolerance = 0.01;      // dB, rounding of coeffitients to float
+        std::vector<double> freq(points);
+        std::vector<std::complex<double>> response(points);
+
+        for (const af::FIR_Spec_Band& band : bands) {
+            for (std::size_t i = 0; i < points; i++) {
+                freq[i] = band.freq_begin + (band.freq_end - band.freq_begin) * static_cast<double>(i) / static_cast<double>(points - 1);
+            }
+            filter.frequency_response(freq.data(), response.data(), points);
+
+            for (std::size_t i = 0; i < points; i++) {
+                const double gain = 20.0 * std::log10(std::max(std::abs(response[i]), 1e-300));
+                const bool within = band.pass ? gain >= -pass_ripple - tolerance && gain <= tolerance : gain <= -stop_atten + tolerance;
+                if (!within) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks that Kaiser, halfband, equiripple and elliptic designs meet specifications they were designed for.
+     * @return Returns true if every design passes.
+     */
+    template <typename T>
+    bool check_designs(const std::string& type)
+    {
+        const double fs = 48000.0;
+        bool ok = true;
+
+        const af::FIR_Spec low{3000.0, 3500.0, 0.1, 80.0};
+        ok &= report_spec("kaiser_lowpass<" + type + ">", fir_spec_met<T>(af::kaiser_lowpass<T>(fs, "Lowpass", low),
+            {{0.0, 3000.0, true}, {3500.0, 0.5 * fs, false}}, low.pass_ripple, low.stop_atten));
+
+        const af::FIR_Spec high{3500.0, 3000.0, 0.1, 80.0};
+        ok &= report_spec("kaiser_highpass<" + type + ">", fir_spec_met<T>(af::kaiser_highpass<T>(fs, "Highpass", high),
+            {{0.0, 3000.0, false}, {3500.0, 0.5 * fs, true}}, high.pass_ripple, high.stop_atten));
+
+        const af::FIR_Band_Spec pass{1000.0, 3000.0, 700.0, 3400.0, 0.1, 60.0};
+        ok &= report_spec("kaiser_bandpass<" + type + ">", fir_spec_met<T>(af::kaiser_bandpass<T>(fs, "Bandpass", pass),
+            {{0.0, 700.0, false}, {1000.0, 3000.0, true}, {3400.0, 0.5 * fs, false}}, pass.pass_ripple, pass.stop_atten));
+
+        const af::FIR_Band_Spec stop{700.0, 3400.0, 1000.0, 3000.0, 0.1, 60.0};
+        ok &= report_spec("kaiser_bandstop<" + type + ">", fir_spec_met<T>(af::kaiser_bandstop<T>(fs, "Bandstop", stop),
+            {{0.0, 700.0, true}, {1000.0, 3000.0, false}, {3400.0, 0.5 * fs, true}}, stop.pass_ripple, stop.stop_atten));
+
+        // halfband has the same deviation in both bands, passband ripple in dB equivalent to it
+        const double delta = std::pow(10.0, -80.0 / 20.0);
+        ok &= report_spec("halfband_lowpass<" + type + ">", fir_spec_met<T>(af::halfband_lowpass<T>(fs, "Halfband", 2000.0, 80.0),
+            {{0.0, 11000.0, true}, {13000.0, 0.5 * fs, false}}, 20.0 * std::log10((1.0 + delta) / (1.0 - delta)), 80.0));
+
+        ok &= report_spec("remez_lowpass<" + type + ">", fir_spec_met<T>(af::remez_lowpass<T>(fs, "Lowpass", low),
+            {{0.0, 3000.0, true}, {3500.0, 0.5 * fs, false}}, low.pass_ripple, low.stop_atten));
+        ok &= report_spec("remez_highpass<" + type + ">", fir_spec_met<T>(af::remez_highpass<T>(fs, "Highpass", high),
+            {{0.0, 3000.0, false}, {3500.0, 0.5 * fs, true}}, high.pass_ripple, high.stop_atten));
+        ok &= report_spec("remez_bandpass<" + type + ">", fir_spec_met<T>(af::remez_bandpass<T>(fs, "Bandpass", pass),
+            {{0.0, 700.0, false}, {1000.0, 3000.0, true}, {3400.0, 0.5 * fs, false}}, pass.pass_ripple, pass.stop_atten));
+        ok &= report_spec("remez_bandstop<" + type + ">", fir_spec_met<T>(af::remez_bandstop<T>(fs, "Bandstop", stop),
+            {{0.0, 700.0, true}, {1000.0, 3000.0, false}, {3400.0, 0.5 * fs, true}}, stop.pass_ripple, stop.stop_atten));
+
+        const af::IIR_Spec iir_low{3000.0, 3500.0, 0.5, 60.0};
+        ok &= report_spec("EllipticLowpass<" + type + ">", iir_spec_met<T>(af::EllipticLowpass<T>(fs, "EllipticLowpass", iir_low),
+            {{0.0, 3000.0, true}, {3500.0, 0.5 * fs, false}}, iir_low.pass_ripple, iir_low.stop_atten));
+
+        const af::IIR_Spec iir_high{3500.0, 3000.0, 0.5, 60.0};
+        ok &= report_spec("EllipticHighpass<" + type + ">", iir_spec_met<T>(af::EllipticHighpass<T>(fs, "EllipticHighpass", iir_high),
+            {{0.0, 3000.0, false}, {3500.0, 0.5 * fs, true}}, iir_high.pass_ripple, iir_high.stop_atten));
+
+        const af::IIR_Band_Spec iir_pass{1000.0, 3000.0, 700.0, 3400.0, 0.5, 60.0};
+        ok &= report_spec("EllipticBandpass<" + type + ">", iir_spec_met<T>(af::EllipticBandpass<T>(fs, "EllipticBandpass", iir_pass),
+            {{0.0, 700.0, false}, {1000.0, 3000.0, true}, {3400.0, 0.5 * fs, false}}, iir_pass.pass_ripple, iir_pass.stop_atten));
+
+        const af::IIR_Band_Spec iir_stop{700.0, 3400.0, 1000.0, 3000.0, 0.5, 60.0};
+        ok &= report_spec("EllipticBandstop<" + type + ">", iir_spec_met<T>(af::EllipticBandstop<T>(fs, "EllipticBandstop", iir_stop),
+            {{0.0, 700.0, true}, {1000.0, 3000.0, false}, {3400.0, 0.5 * fs, true}}, iir_stop.pass_ripple, iir_stop.stop_atten));
+
+        return ok;
+    }
+
+    template <typename T>
+    bool certify(const std::string& type)
+    {
+        const double fs = 48000.0;
+        bool ok = true;
+
+        af::FIR<T> fir(fs, "FIR", std::vector<T>(65, static_cast<T>(0.01)));
+        ok &= report("FIR<" + type + ">", run_checked<T>(fir, [&] { fir.request_coeff(std::vector<T>(65, static_cast<T>(0.02)), 64); }));
+
+        af::IIR<T> iir(fs, "IIR", std::vector<T>{0.2, 0.4, 0.2}, std::vector<T>{-0.5, 0.2});
+        ok &= report("IIR<" + type + ">", run_checked<T>(iir, [&] { iir.request_coeff(std::vector<T>{0.3, 0.3, 0.3}, std::vector<T>{-0.4, 0.1}, 64); }));
+
+        af::Lowpass<T> lowpass(fs, "Lowpass", 128, 3000.0);
+        ok &= report("Lowpass<" + type + ">", run_checked<T>(lowpass, [&] { lowpass.request_coeffs(128, 2000.0, 64); }));
+
+        af::Highpass<T> highpass(fs, "Highpass", 128, 3000.0);
+        ok &= report("Highpass<" + type + ">", run_checked<T>(highpass, [&] { highpass.request_coeffs(128, 2000.0); }));
+
+        af::Bandpass<T> bandpass(fs, "Bandpass", 128, 300.0, 3000.0);
+        ok &= report("Bandpass<" + type + ">", run_checked<T>(bandpass, [&] { bandpass.request_coeffs(128, 400.0, 3000.0); }));
+
+        af::Bandstop<T> bandstop(fs, "Bandstop", 128, 300.0, 3000.0);
+        ok &= report("Bandstop<" + type + ">", run_checked<T>(bandstop, [&] { bandstop.request_coeffs(128, 400.0, 3000.0); }));
+
+        af::ChebyshevLowpass<T> cheb_low(fs, "ChebyshevLowpass", 2, 3000.0, 1.0);
+        ok &= report("ChebyshevLowpass<" + type + ">", run_checked<T>(cheb_low, [&] { cheb_low.request_coeffs(2, 2000.0, 1.0, 64); }));
+
+        af::ChebyshevHighpass<T> cheb_high(fs, "ChebyshevHighpass", 2, 300.0, 1.0);
+        ok &= report("ChebyshevHighpass<" + type + ">", run_checked<T>(cheb_high, [&] { cheb_high.request_coeffs(2, 400.0, 1.0); }));
+
+        af::ChebyshevLowpass<T> cheb_sos(fs, "ChebyshevLowpass", 8, 3000.0, 1.0);
+        ok &= report("ChebyshevLowpass<" + type + "> order 8", run_checked<T>(cheb_sos, [&] { cheb_sos.request_coeffs(8, 2000.0, 1.0, 64); }));
+
+        af::Chebyshev2Highpass<T> cheb2_high(fs, "Chebyshev2Highpass", 5, 300.0, 60.0);
+        ok &= report("Chebyshev2Highpass<" + type + ">", run_checked<T>(cheb2_high, [&] { cheb2_high.request_coeffs(7, 400.0, 60.0); }));
+
+        af::ButterworthLowpass<T> butter(fs, "ButterworthLowpass", 6, 3000.0);
+        ok &= report("ButterworthLowpass<" + type + ">", run_checked<T>(butter, [&] { butter.request_coeffs(6, 2000.0, 64); }));
+
+        af::EllipticBandpass<T> elliptic(fs, "EllipticBandpass", af::IIR_Band_Spec{1000.0, 2000.0, 800.0, 2300.0, 0.5, 60.0});
+        ok &= report("EllipticBandpass<" + type + ">", run_checked<T>(elliptic, [&] { elliptic.request_coeffs(af::IIR_Band_Spec{1100.0, 2000.0, 900.0, 2300.0, 0.5, 60.0}, 64); }));
+
+        af::Lowpass<T> halfband = af::halfband_lowpass<T>(fs, "Halfband", 2000.0, 80.0);
+        std::vector<T> halfband_coeff = af::halfband_coeff<T>(fs, 1000.0, 80.0);
+        ok &= report("Halfband<" + type + ">", run_checked<T>(halfband, [&] { halfband.request_coeff(halfband_coeff); }));
+
+        af::MovingAverage<T> average(fs, "MovingAverage", 64);
+        ok &= report("MovingAverage<" + type + ">", run_checked<T>(average, nullptr));
+
+        af::CIC<T> cic(fs, "CIC", af::CIC_Mode::Decimator, 4, 16);
+        ok &= report("CIC<" + type + ">", run_checked<T>(cic, nullptr));
+
+        auto chain = af::decimation_chain<T>(fs, "Decimation", af::Decimation_Spec{2000.0, fs / 8.0, 0.1, 80.0});
+        ok &= report("Decimation chain<" + type + ">", run_checked<T>(*chain, nullptr));
+
+        af::StateVariable<T> svf(fs, "StateVariable", af::SVF_Mode::Bandpass, 3000.0, 0.707);
+        ok &= report("StateVariable<" + type + ">", run_checked<T>(svf, [&] { svf.set_freq_cutoff(2000.0); }));
+
+        ok &= report_clone("FIR<" + type + ">", clone_during_fade<T>(fir, [&] { fir.request_coeff(std::vector<T>(65, static_cast<T>(0.03)), 64); }));
+        ok &= report_clone("IIR<" + type + ">", clone_during_fade<T>(iir, [&] { iir.request_coeff(std::vector<T>{0.2, 0.4, 0.2}, std::vector<T>{-0.5, 0.2}, 64); }));
+        ok &= report_clone("ButterworthLowpass<" + type + ">", clone_during_fade<T>(butter, [&] { butter.request_coeffs(6, 3000.0, 64); }));
+
+        auto cascade = lowpass + cheb_high;
+        auto nested = std::make_unique<af::Cascade<T>>(fs, "Nested cascade");
+        nested->add_filter(*cascade);
+        nested->add_filter(svf);
+        ok &= report("Cascade<" + type + ">", run_checked<T>(*nested, nullptr));
+
+        return ok;
+    }
+
+}
+
+int main()
+{
+    bool ok = certify<float>("float");
+    ok &= certify<double>("double");
+    ok &= check_designs<float>("float");
+    ok &= check_designs<double>("double");
+
+    Allocating_Filter allocating(false);
+    Allocating_Filter locking(true);
+    bool detected = run_checked<float>(allocating, nullptr) > 0 && run_checked<float>(locking, nullptr) > 0;
+    std::cout << (detected ? "PASS  " : "FAIL  ") << "checker detects deliberate allocation and mutex lock" << std::endl;
+
+    return ok && detected ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#include "headers/base_filter.hpp"
+#include "headers/SVFs.hpp"
+#include <iostream>
+
+int main()
+{
+    double fs = 44100.0;
+    double f_square = 500.0; 
+    std::vector<double> samples;
+    std::vector<double> cutoff;
+
+    for (int n = 0; n < 1000; n++) {
+        double t = n / fs;
+        double val = (std::sin(2.0 * M_PI * f_square * t) >= 0) ? 1.0 : -1.0;
+        samples.push_back(val);
+        cutoff.push_back(2000.0 + 1500.0 * std::sin(2.0 * M_PI * 5.0 * t));
+    }
+
+    std::cout << "Input samples for filters: [";
+    for(double s : samples){
+        std::cout << s << " ";
+    }
+    std::cout << "]" << std::endl;
+    std::cout << std::endl;
+
+    af::StateVariable<double> SVF_filter(44100.0, "SVF LPF", af::SVF_Mode::Lowpass, 2000.0, 0.707);
+    std::vector<double> result(samples.size());
+
+    SVF_filter.filter_block(samples.data(), result.data(), cutoff.data(), samples.size());
+
+    std::cout << "Output from SVF LPF with cutoff modulated every sample [ ";
+    for(double r : result){
+        std::cout << r << " ";
+    }
+    std::cout << " ]" << std::endl;
+
+
+    return 0;
+}